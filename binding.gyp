@@ -11,6 +11,7 @@
         'src/create_string.cpp',
         'src/custom_function_bridge.cpp',
         'src/custom_importer_bridge.cpp',
+        'src/importer_cache.cpp',
         'src/sass_context_wrapper.cpp',
         'src/sass_types/boolean.cpp',
         'src/sass_types/color.cpp',
@@ -69,6 +70,42 @@
           }
         }]
       ]
+    },
+    {
+      # the sample plugin of libsass, loaded by the tests through pluginPaths
+      'target_name': 'sample_plugin',
+      'type': 'shared_library',
+      'product_prefix': '',
+      'product_dir': '<(PRODUCT_DIR)/plugins',
+      'sources': [
+        'src/libsass/contrib/plugin.cpp'
+      ],
+      'xcode_settings': {
+        'CLANG_CXX_LIBRARY': 'libc++',
+        'MACOSX_DEPLOYMENT_TARGET': '10.11'
+      },
+      'msvs_settings': {
+        'VCLinkerTool': {
+          'AdditionalOptions': [
+            '/EXPORT:libsass_get_version',
+            '/EXPORT:libsass_load_functions',
+            '/EXPORT:libsass_load_importers'
+          ]
+        }
+      },
+      'conditions': [
+        ['libsass_ext == "" or libsass_ext == "no"', {
+          'dependencies': [
+            'src/libsass.gyp:libsass',
+          ]
+        }, {
+          # plugins link their own copy of the bundled libsass
+          'type': 'none',
+          'sources!': [
+            'src/libsass/contrib/plugin.cpp'
+          ]
+        }]
+      ]
     }
   ]
 }
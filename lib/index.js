@@ -106,6 +106,22 @@ function getStyle(options) {
   return styles[options.outputStyle] || 0;
 }
 
+/**
+ * Get profile style
+ *
+ * @param {Object} options
+ * @api private
+ */
+
+function getProfileStyle(options) {
+  var styles = {
+    flat: 1,
+    trace: 2
+  };
+
+  return styles[options.profile] || 0;
+}
+
 /**
  * Get indent width
  *
@@ -178,6 +194,52 @@ function buildIncludePaths(options) {
   return options.includePaths.join(path.delimiter);
 }
 
+/**
+ * Build a pluginPaths string from the options.pluginPaths array
+ *
+ * @param {Object} options
+ * @api private
+ */
+
+function buildPluginPaths(options) {
+  return [].concat(options.pluginPaths || []).map(function(pluginPath) {
+    return path.resolve(pluginPath);
+  }).join(path.delimiter);
+}
+
+/**
+ * Get the options of a variant, which override those of the render
+ *
+ * @param {Object} opts
+ * @param {Object} variant
+ * @api private
+ */
+
+function getVariantOptions(opts, variant) {
+  if (typeof variant !== 'object' || variant === null) {
+    throw new Error('Invalid: variant is not an object.');
+  }
+  var options = Object.assign({}, opts, variant, { variants: undefined });
+
+  options.prelude = variant.prelude ? String(variant.prelude) : '';
+  options.sourceComments = options.sourceComments || false;
+  options.extendThreads = parseInt(options.extendThreads) || 0;
+  options.outputThreads = parseInt(options.outputThreads) || 0;
+  options.outFile = getOutputFile(options);
+  options.precision = parseInt(options.precision) || 5;
+  options.sourceMap = getSourceMap(options);
+  options.style = getStyle(options);
+  options.indentWidth = getIndentWidth(options);
+  options.indentType = getIndentType(options);
+  options.linefeed = getLinefeed(options);
+
+  options.result = {
+    stats: getStats(options)
+  };
+
+  return options;
+}
+
 /**
  * Get options
  *
@@ -191,19 +253,43 @@ function getOptions(opts, cb) {
   }
   var options = clonedeep(opts || {});
 
+  // shared with other renders, so not copied
+  if (opts && opts.importerResultCache) {
+    options.importerResultCache = opts.importerResultCache;
+  }
+  if (opts && opts.signal) {
+    options.signal = opts.signal;
+  }
+
   options.sourceComments = options.sourceComments || false;
+  options.memoizeFunctions = options.memoizeFunctions || false;
+  options.memoizeMixins = options.memoizeMixins || false;
+  options.parseThreads = parseInt(options.parseThreads) || 0;
+  options.extendThreads = parseInt(options.extendThreads) || 0;
+  options.outputThreads = parseInt(options.outputThreads) || 0;
+  options.timeLimit = Math.max(parseInt(options.timeLimit) || 0, 0);
+  options.nodeLimit = Math.max(parseInt(options.nodeLimit) || 0, 0);
+  options.outputLimit = Math.max(parseInt(options.outputLimit) || 0, 0);
   if (Object.prototype.hasOwnProperty.call(options, 'file')) {
     options.file = getInputFile(options);
   }
   options.outFile = getOutputFile(options);
   options.includePaths = buildIncludePaths(options);
+  options.pluginPaths = buildPluginPaths(options);
   options.precision = parseInt(options.precision) || 5;
   options.sourceMap = getSourceMap(options);
   options.style = getStyle(options);
+  options.profileStyle = getProfileStyle(options);
   options.indentWidth = getIndentWidth(options);
   options.indentType = getIndentType(options);
   options.linefeed = getLinefeed(options);
 
+  if (Array.isArray(options.variants)) {
+    options.variants = options.variants.map(function(variant) {
+      return getVariantOptions(opts, variant);
+    });
+  }
+
   // context object represents node-sass environment
   options.context = { options: options, callback: cb };
 
@@ -214,6 +300,30 @@ function getOptions(opts, cb) {
   return options;
 }
 
+/**
+ * Ids of the importer functions seen so far, which key their results
+ * in an `importerResultCache`
+ */
+
+var importerIds = new WeakMap();
+var lastImporterId = 0;
+
+/**
+ * Get the id of an importer function
+ *
+ * @param {Function} importer
+ * @return {Number}
+ * @api private
+ */
+
+function getImporterId(importer) {
+  if (!importerIds.has(importer)) {
+    importerIds.set(importer, ++lastImporterId);
+  }
+
+  return importerIds.get(importer);
+}
+
 /**
  * Executes a callback and transforms any exception raised into a sass error
  *
@@ -239,15 +349,23 @@ function tryCallback(callback, args) {
 /**
  * Normalizes the signature of custom functions to make it possible to just supply the
  * function name and have the signature default to `fn(...)`. The callback is adjusted
- * to transform the input sass list into discrete arguments.
+ * to transform the input sass list into discrete arguments. A function may also be
+ * given as `{ fn: callback, pure: true }` to have its results cached.
  *
  * @param {String} signature
- * @param {Function} callback
+ * @param {Function|Object} callback
  * @return {Object}
  * @api private
  */
 
 function normalizeFunctionSignature(signature, callback) {
+  var pure = false;
+
+  if (callback && typeof callback === 'object') {
+    pure = Boolean(callback.pure);
+    callback = callback.fn;
+  }
+
   if (!/^\*|@warn|@error|@debug|\w+\(.*\)$/.test(signature)) {
     if (!/\w+/.test(signature)) {
       throw new Error('Invalid function signature format "' + signature + '"');
@@ -265,16 +383,37 @@ function normalizeFunctionSignature(signature, callback) {
         }
 
         return callback.apply(this, args);
-      }
+      },
+      pure: pure
     };
   }
 
   return {
     signature: signature,
-    callback: callback
+    callback: callback,
+    pure: pure
   };
 }
 
+/**
+ * Get the payload of a render from its result
+ *
+ * @param {Object} result
+ * @api private
+ */
+
+function getPayload(result) {
+  var payload = {
+    css: result.css,
+    stats: endStats(result.stats)
+  };
+  if (result.map) {
+    payload.map = result.map;
+  }
+
+  return payload;
+}
+
 /**
  * Render
  *
@@ -284,27 +423,39 @@ function normalizeFunctionSignature(signature, callback) {
 
 module.exports.render = function(opts, cb) {
   var options = getOptions(opts, cb);
+  var signal = options.signal;
+  var handle;
+
+  function abort() {
+    handle.cancel();
+  }
 
   // options.error and options.success are for libsass binding
   options.error = function(err) {
+    if (signal) {
+      signal.removeEventListener('abort', abort);
+    }
+
     var payload = Object.assign(new Error(), JSON.parse(err));
 
+    if (options.result.variant !== undefined) {
+      payload.variant = options.result.variant;
+    }
+
     if (cb) {
       options.context.callback.call(options.context, payload, null);
     }
   };
 
   options.success = function() {
-    var result = options.result;
-    var stats = endStats(result.stats);
-    var payload = {
-      css: result.css,
-      stats: stats
-    };
-    if (result.map) {
-      payload.map = result.map;
+    if (signal) {
+      signal.removeEventListener('abort', abort);
     }
 
+    var payload = options.variants ? options.variants.map(function(variant) {
+      return getPayload(variant.result);
+    }) : getPayload(options.result);
+
     if (cb) {
       options.context.callback.call(options.context, null, payload);
     }
@@ -327,6 +478,7 @@ module.exports.render = function(opts, cb) {
             done(result);
           }
         };
+        options.importer[index].cacheId = getImporterId(subject);
       });
     } else {
       options.importer = function(file, prev, bridge) {
@@ -340,6 +492,7 @@ module.exports.render = function(opts, cb) {
           done(result);
         }
       };
+      options.importer.cacheId = getImporterId(importer);
     }
   }
 
@@ -365,16 +518,26 @@ module.exports.render = function(opts, cb) {
           done(result);
         }
       };
+      options.functions[cb.signature].pure = cb.pure;
     });
   }
 
   if (options.data) {
-    binding.render(options);
+    handle = binding.render(options);
   } else if (options.file) {
-    binding.renderFile(options);
+    handle = binding.renderFile(options);
   } else {
     cb({status: 3, message: 'No input specified: provide a file name or a source string to process' });
   }
+
+  // the compile stops at its next checkpoint and fails with status 6
+  if (signal && handle) {
+    if (signal.aborted) {
+      abort();
+    } else {
+      signal.addEventListener('abort', abort);
+    }
+  }
 };
 
 /**
@@ -397,6 +560,7 @@ module.exports.renderSync = function(opts) {
 
           return result === module.exports.NULL ? null : result;
         };
+        options.importer[index].cacheId = getImporterId(subject);
       });
     } else {
       options.importer = function(file, prev) {
@@ -404,6 +568,7 @@ module.exports.renderSync = function(opts) {
 
         return result === module.exports.NULL ? null : result;
       };
+      options.importer.cacheId = getImporterId(importer);
     }
   }
 
@@ -418,6 +583,7 @@ module.exports.renderSync = function(opts) {
       options.functions[cb.signature] = function() {
         return tryCallback(cb.callback.bind(options.context), arguments);
       };
+      options.functions[cb.signature].pure = cb.pure;
     });
   }
 
@@ -433,11 +599,138 @@ module.exports.renderSync = function(opts) {
   var result = options.result;
 
   if (status) {
+    if (options.variants) {
+      return options.variants.map(function(variant) {
+        variant.result.stats = endStats(variant.result.stats);
+        return variant.result;
+      });
+    }
     result.stats = endStats(result.stats);
     return result;
   }
 
-  throw Object.assign(new Error(), JSON.parse(result.error));
+  var error = Object.assign(new Error(), JSON.parse(result.error));
+
+  if (result.variant !== undefined) {
+    error.variant = result.variant;
+  }
+
+  throw error;
+};
+
+/**
+ * Render variants
+ *
+ * Parses the input and its imports once, then compiles it for every
+ * variant: its prelude is evaluated before the input and its output
+ * options override those of the render.
+ *
+ * @param {Object} options
+ * @param {Function} cb
+ * @api public
+ */
+
+module.exports.renderVariants = function(opts, cb) {
+  module.exports.render(Object.assign({}, opts, { variants: [].concat(opts.variants || []) }), cb);
+};
+
+/**
+ * Render variants sync
+ *
+ * @param {Object} options
+ * @api public
+ */
+
+module.exports.renderVariantsSync = function(opts) {
+  return module.exports.renderSync(Object.assign({}, opts, { variants: [].concat(opts.variants || []) }));
+};
+
+/**
+ * Merges the import graph of a render into graph
+ *
+ * @param {Object} graph
+ * @param {Object} stats
+ * @api private
+ */
+
+function mergeImports(graph, stats) {
+  Object.keys(stats.imports).forEach(function(file) {
+    var children = graph[file] || (graph[file] = []);
+
+    stats.imports[file].forEach(function(child) {
+      if (children.indexOf(child) === -1) {
+        children.push(child);
+      }
+    });
+  });
+
+  return graph;
+}
+
+/**
+ * Dependencies
+ *
+ * Resolves the imports of one or more entry files the way a render
+ * would, without evaluating them. Entries are parsed in parallel.
+ *
+ * @param {String|Array} files
+ * @param {Object} options
+ * @param {Function} cb
+ * @api public
+ */
+
+module.exports.dependencies = function(files, opts, cb) {
+  if (typeof opts === 'function') {
+    cb = opts;
+    opts = {};
+  }
+
+  files = [].concat(files);
+
+  var graph = {},
+    pending = files.length,
+    failed = false;
+
+  if (!pending) {
+    return cb(null, graph);
+  }
+
+  files.forEach(function(file) {
+    var options = Object.assign({}, opts, { file: file, data: undefined, parseOnly: true });
+
+    module.exports.render(options, function(err, result) {
+      if (failed) {
+        return;
+      }
+
+      if (err) {
+        failed = true;
+        return cb(err, null);
+      }
+
+      mergeImports(graph, result.stats);
+
+      if (--pending === 0) {
+        cb(null, graph);
+      }
+    });
+  });
+};
+
+/**
+ * Dependencies sync
+ *
+ * @param {String|Array} files
+ * @param {Object} options
+ * @api public
+ */
+
+module.exports.dependenciesSync = function(files, opts) {
+  return [].concat(files).reduce(function(graph, file) {
+    var options = Object.assign({}, opts, { file: file, data: undefined, parseOnly: true });
+
+    return mergeImports(graph, module.exports.renderSync(options).stats);
+  }, {});
 };
 
 /**
@@ -448,6 +741,31 @@ module.exports.renderSync = function(opts) {
 
 module.exports.info = sass.getVersionInfo(binding);
 
+/**
+ * Heap statistics (only nodes allocated while
+ * heap tracking is enabled are counted)
+ *
+ * @api public
+ */
+
+module.exports.setHeapTracking = function(enabled) {
+  binding.setHeapTracking(!!enabled);
+};
+
+module.exports.getHeapStats = function() {
+  return binding.getHeapStats();
+};
+
+/**
+ * Cache of custom importer results, shared by the renders
+ * it is passed to as `importerResultCache` (the imports
+ * are still parsed again on every hit)
+ *
+ * @api public
+ */
+
+module.exports.ImporterResultCache = binding.ImporterResultCache;
+
 /**
  * Expose sass types
  */
@@ -18,6 +18,7 @@ var chalk = require('chalk'),
 module.exports = function(options, emitter) {
   var renderOptions = {
     includePaths: options.includePath,
+    pluginPaths: options.pluginPath,
     omitSourceMapUrl: options.omitSourceMapUrl,
     indentedSyntax: options.indentedSyntax,
     outFile: options.dest,
@@ -29,12 +30,19 @@ module.exports = function(options, emitter) {
     sourceMap: options.sourceMap,
     sourceMapRoot: options.sourceMapRoot,
     importer: options.importer,
+    importerResultCache: options.importerResultCache,
     functions: options.functions,
     indentWidth: options.indentWidth,
     indentType: options.indentType,
     linefeed: options.linefeed
   };
 
+  // profile style follows the extension of the report file
+  var profile = options.profile && path.resolve(options.profile);
+  if (profile) {
+    renderOptions.profile = path.extname(profile) === '.json' ? 'trace' : 'flat';
+  }
+
   if (options.data) {
     renderOptions.data = options.data;
   } else if (options.src) {
@@ -53,6 +61,24 @@ module.exports = function(options, emitter) {
       }
     };
 
+    if (profile) {
+      todo++;
+
+      fs.mkdir(path.dirname(profile), {recursive: true}, function(err) {
+        if (err) {
+          return emitter.emit('error', chalk.red(err));
+        }
+        fs.writeFile(profile, result.profile, function(err) {
+          if (err) {
+            return emitter.emit('error', chalk.red('Error' + err));
+          }
+
+          emitter.emit('info', chalk.green('Wrote Profile to ' + profile));
+          done();
+        });
+      });
+    }
+
     if (!destination || stdin) {
       emitter.emit('log', result.css.toString());
 
@@ -0,0 +1,369 @@
+/*!
+ * node-sass: lib/server.js
+ */
+
+var Emitter = require('events').EventEmitter,
+  fs = require('fs'),
+  net = require('net'),
+  path = require('path');
+
+/**
+ * Events of a render forwarded from the server to the client
+ */
+
+var events = ['info', 'warn', 'log', 'error', 'done'];
+
+/**
+ * Options holding paths, resolved by the client as the server
+ * runs in a different working directory
+ */
+
+var pathOptions = ['src', 'dest', 'importer', 'functions', 'profile'];
+var pathListOptions = ['includePath', 'pluginPath'];
+
+/**
+ * Resolve the paths of a job relative to the working directory
+ *
+ * @param {Object} options
+ * @returns {Object}
+ * @api private
+ */
+
+function resolveJob(options) {
+  var job = Object.assign({}, options);
+
+  pathOptions.forEach(function(key) {
+    if (typeof job[key] === 'string') {
+      job[key] = path.resolve(job[key]);
+    }
+  });
+
+  pathListOptions.forEach(function(key) {
+    if (Array.isArray(job[key])) {
+      job[key] = job[key].map(function(dir) {
+        return path.resolve(dir);
+      });
+    }
+  });
+
+  if (job.sourceMap && job.sourceMap !== true) {
+    job.sourceMap = path.resolve(job.sourceMap);
+  }
+
+  return job;
+}
+
+/**
+ * Read newline delimited JSON messages from a socket
+ *
+ * Stops reading at the first line that is not valid JSON
+ * and passes the parse error to onInvalid.
+ *
+ * @param {Object} socket
+ * @param {Function} onMessage
+ * @param {Function} onInvalid
+ * @api private
+ */
+
+function readMessages(socket, onMessage, onInvalid) {
+  var buffer = '';
+  var invalid = false;
+
+  socket.setEncoding('utf8');
+  socket.on('data', function(chunk) {
+    if (invalid) {
+      return;
+    }
+
+    var lines = (buffer + chunk).split('\n');
+    buffer = lines.pop();
+
+    for (var i = 0; i < lines.length; i++) {
+      if (!lines[i]) {
+        continue;
+      }
+
+      var message;
+      try {
+        message = JSON.parse(lines[i]);
+      } catch (e) {
+        invalid = true;
+        onInvalid(e);
+        return;
+      }
+      onMessage(message);
+    }
+  });
+}
+
+/**
+ * Remove a socket left behind by a server that did not shut down
+ *
+ * Only removes the file when it is a socket nobody listens on,
+ * anything else at socketPath is reported as an error.
+ *
+ * @param {String} socketPath
+ * @param {Function} callback
+ * @api private
+ */
+
+function removeStaleSocket(socketPath, callback) {
+  var stats;
+
+  if (process.platform === 'win32') {
+    return callback();
+  }
+
+  try {
+    stats = fs.statSync(socketPath);
+  } catch (e) {
+    return callback();
+  }
+
+  if (!stats.isSocket()) {
+    return callback(new Error(socketPath + ' exists and is not a socket'));
+  }
+
+  var probe = net.connect(socketPath);
+
+  probe.on('connect', function() {
+    probe.destroy();
+    callback(new Error('A compile server is already listening on ' + socketPath));
+  });
+
+  probe.on('error', function() {
+    try {
+      fs.unlinkSync(socketPath);
+    } catch (e) {
+      return callback(e);
+    }
+    callback();
+  });
+}
+
+/**
+ * Require a module of custom importers or functions once, so that
+ * later jobs get the already loaded module
+ *
+ * @param {String} file
+ * @returns {Object|Function}
+ * @api private
+ */
+
+function requireOption(file) {
+  return typeof file === 'string' ? require(file) : file;
+}
+
+/**
+ * Wrap the importers of a module, so that the files their results point
+ * to are recorded in watched (keyed by url and prev). The wrappers are
+ * made once per module and keep their ids in the importer cache.
+ *
+ * @param {Function|Array} importer
+ * @param {Map} wrappers
+ * @param {Object} watched
+ * @returns {Function|Array}
+ * @api private
+ */
+
+function watchImporter(importer, wrappers, watched) {
+  if (Array.isArray(importer)) {
+    return importer.map(function(subject) {
+      return watchImporter(subject, wrappers, watched);
+    });
+  }
+
+  if (typeof importer !== 'function') {
+    return importer;
+  }
+
+  if (!wrappers.has(importer)) {
+    wrappers.set(importer, function(url, prev, done) {
+      var record = function(result) {
+        watched[url + '\n' + prev] = { url: url, prev: prev, files: resultFiles(result, prev) };
+        return result;
+      };
+      var result = importer.call(this, url, prev, function(result) {
+        done(record(result));
+      });
+
+      return result === undefined ? result : record(result);
+    });
+  }
+
+  return wrappers.get(importer);
+}
+
+/**
+ * Get the files an importer result points to with their modification
+ * times. A result naming a file that does not exist as given (e.g. one
+ * LibSass still has to look up on the include paths) can't be watched
+ * and is marked with a null time.
+ *
+ * @param {Object|Array} result
+ * @param {String} prev
+ * @returns {Array}
+ * @api private
+ */
+
+function resultFiles(result, prev) {
+  var results = Array.isArray(result) ? result : [result];
+
+  return results.filter(function(result) {
+    return result && typeof result.file === 'string';
+  }).map(function(result) {
+    var file = path.isAbsolute(prev) ? path.resolve(path.dirname(prev), result.file) : path.resolve(result.file);
+    try {
+      return { file: file, mtime: fs.statSync(file).mtimeMs };
+    } catch (e) {
+      return { file: file, mtime: null };
+    }
+  });
+}
+
+/**
+ * Drop the cached importer results for files that changed since
+ * they were imported
+ *
+ * @param {Object} cache
+ * @param {Object} watched
+ * @api private
+ */
+
+function invalidateImports(cache, watched) {
+  Object.keys(watched).forEach(function(key) {
+    var entry = watched[key];
+    var changed = entry.files.some(function(file) {
+      try {
+        return file.mtime === null || fs.statSync(file.file).mtimeMs !== file.mtime;
+      } catch (e) {
+        return true;
+      }
+    });
+
+    if (changed) {
+      cache.delete(entry.url, entry.prev);
+      delete watched[key];
+    }
+  });
+}
+
+/**
+ * Start a compile server on a Unix socket (or a named pipe on Windows)
+ *
+ * Every connection submits one job: the options of the CLI for a
+ * single render. The server keeps the binding and the modules of
+ * custom importers and functions loaded between jobs, and answers
+ * with the events the CLI would have emitted for the render. The
+ * results of custom importers are cached for all jobs and dropped
+ * once a file they point to is modified.
+ *
+ * @param {String} socketPath
+ * @param {Object} emitter
+ * @returns {Object}
+ * @api public
+ */
+
+module.exports.listen = function(socketPath, emitter) {
+  var render = require('./render');
+  var sass = require('./');
+  var importerResultCache = new sass.ImporterResultCache();
+  var wrappers = new Map();
+  var watched = {};
+
+  var server = net.createServer(function(socket) {
+    readMessages(socket, function(job) {
+      var relay = new Emitter();
+
+      events.forEach(function(event) {
+        relay.on(event, function(data) {
+          if (!socket.writable) {
+            return;
+          }
+          socket.write(JSON.stringify({ event: event, data: data }) + '\n');
+          if (event === 'done' || event === 'error') {
+            socket.end();
+          }
+        });
+      });
+
+      try {
+        job.importer = watchImporter(requireOption(job.importer), wrappers, watched);
+        job.functions = requireOption(job.functions);
+        job.importerResultCache = importerResultCache;
+        invalidateImports(importerResultCache, watched);
+        render(job, relay);
+      } catch (e) {
+        relay.emit('error', String(e && e.stack || e));
+      }
+    }, function(err) {
+      socket.end(JSON.stringify({ event: 'error', data: 'Invalid message: ' + err.message }) + '\n');
+    });
+
+    socket.on('error', function() {
+      // the client went away, nothing left to report
+    });
+  });
+
+  server.on('error', emitter.emit.bind(emitter, 'error'));
+  removeStaleSocket(socketPath, function(err) {
+    if (err) {
+      return emitter.emit('error', err.message);
+    }
+    server.listen(socketPath, function() {
+      emitter.emit('info', 'Listening on ' + socketPath);
+    });
+  });
+
+  var close = function() {
+    server.close();
+    process.exit();
+  };
+  process.once('SIGINT', close);
+  process.once('SIGTERM', close);
+
+  return server;
+};
+
+/**
+ * Submit a render to a compile server and replay its events on emitter
+ *
+ * @param {String} socketPath
+ * @param {Object} options
+ * @param {Object} emitter
+ * @api public
+ */
+
+module.exports.submit = function(socketPath, options, emitter) {
+  var socket = net.connect(socketPath);
+  var finished = false;
+
+  socket.on('connect', function() {
+    socket.write(JSON.stringify(resolveJob(options)) + '\n');
+  });
+
+  readMessages(socket, function(message) {
+    if (message.event === 'done' || message.event === 'error') {
+      finished = true;
+    }
+    emitter.emit(message.event, message.data);
+  }, function(err) {
+    finished = true;
+    socket.destroy();
+    emitter.emit('error', 'Invalid reply from the compile server at ' + socketPath + ': ' + err.message);
+  });
+
+  socket.on('error', function(err) {
+    if (!finished) {
+      finished = true;
+      emitter.emit('error', 'Could not reach the compile server at ' + socketPath + ': ' + err.message);
+    }
+  });
+
+  socket.on('close', function() {
+    if (!finished) {
+      finished = true;
+      emitter.emit('error', 'The compile server at ' + socketPath + ' closed the connection');
+    }
+  });
+};
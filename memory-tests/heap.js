@@ -0,0 +1,40 @@
+'use strict';
+
+var assert = require('assert');
+var sass = require('../');
+
+// renders a stylesheet over and over and checks that
+// all nodes allocated by libsass are released again
+var src = [
+  '$colors: (primary: #007bff, danger: #dc3545);',
+  '@function double($n) { @return $n * 2; }',
+  '@mixin button($color) { color: $color; &:hover { color: darken($color, 10%); } }',
+  '%base { margin: 0; }',
+  '@each $name, $color in $colors {',
+  '  .btn-#{$name} { @extend %base; @include button($color); width: double(10px); }',
+  '}'
+].join('\n');
+
+function liveNodes() {
+  var types = sass.getHeapStats().types;
+  var live = {};
+  Object.keys(types).forEach(function(name) {
+    live[name] = types[name].live;
+  });
+  return live;
+}
+
+sass.setHeapTracking(true);
+sass.renderSync({ data: src });
+var baseline = liveNodes();
+
+for (var i = 1; i <= 100000; i++) {
+  sass.renderSync({ data: src, sourceMap: true, outFile: 'out.css' });
+  if (i % 1000 === 0) {
+    var live = liveNodes();
+    Object.keys(live).forEach(function(name) {
+      assert.strictEqual(live[name], baseline[name] || 0, name + ' nodes leaked after ' + i + ' renders');
+    });
+    console.log(i, process.memoryUsage().rss / 1000000);
+  }
+}
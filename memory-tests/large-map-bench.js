@@ -0,0 +1,34 @@
+'use strict';
+
+var sass = require('../');
+
+// time per call of a custom function receiving a large map, either
+// reading a single entry or all of them
+var entries = [];
+for (var i = 0; i < 2000; i++) {
+  entries.push('key-' + i + ': ' + i + 'px');
+}
+
+var calls = 200;
+var src = '$config: (' + entries.join(', ') + ');\n' +
+  '@for $i from 1 through ' + calls + ' { .a-#{$i} { width: pick($config); } }';
+
+function run(name, fn) {
+  var start = process.hrtime();
+  sass.renderSync({ data: src, functions: { 'pick($map)': fn } });
+  var time = process.hrtime(start);
+  var ms = (time[0] * 1e3 + time[1] / 1e6) / calls;
+  console.log(name + ': ' + ms.toFixed(3) + ' ms per call');
+}
+
+run('one entry', function(map) {
+  return map.getValue(0);
+});
+
+run('all entries', function(map) {
+  var sum = 0;
+  for (var i = 0; i < map.getLength(); i++) {
+    sum += map.getValue(i).getValue();
+  }
+  return new sass.types.Number(sum, 'px');
+});
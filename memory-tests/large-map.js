@@ -0,0 +1,26 @@
+'use strict';
+
+var sass = require('../');
+var iterateAndMeasure = require('./_measure');
+
+// a config map passed to a custom function, which reads all of it
+var entries = [];
+for (var i = 0; i < 2000; i++) {
+  entries.push('key-' + i + ': ' + i + 'px');
+}
+
+iterateAndMeasure(function() {
+  sass.renderSync({
+    data: '$config: (' + entries.join(', ') + '); a { width: total($config); }',
+    functions: {
+      'total($map)': function(map) {
+        var sum = 0;
+        for (var i = 0; i < map.getLength(); i++) {
+          map.getKey(i).getValue();
+          sum += map.getValue(i).getValue();
+        }
+        return new sass.types.Number(sum, 'px');
+      }
+    }
+  });
+}, 100);
@@ -0,0 +1,34 @@
+'use strict';
+
+var sass = require('../');
+
+// extends a large component stylesheet (many top level rulesets that
+// extend a few shared placeholders and each other) on 1 to 16 threads
+var blocks = Number(process.argv[2]) || 1000;
+var runs = 5;
+
+var src = ['%button { padding: 4px; }', '%card { margin: 8px; }'];
+for (var i = 0; i < blocks; i++) {
+  src.push('.btn-' + i + ' { @extend %button; color: red; &:hover .icon-' + (i % 50) + ' { color: blue; } }');
+  src.push('.card-' + i + ' > .title { @extend %card; } .card-' + i + ' .btn-' + i + ' { margin: 0; }');
+  src.push('.panel-' + i + ' { @extend .btn-' + i + '; }');
+}
+src = src.join('\n');
+// the runs only differ in the extend phase
+var options = { data: src, outFile: 'out.css', sourceMap: true };
+
+function run(extendThreads) {
+  var total = 0;
+  var extend = 0;
+  for (var r = 0; r < runs; r++) {
+    var start = process.hrtime();
+    var result = sass.renderSync(Object.assign({ extendThreads: extendThreads }, options));
+    var time = process.hrtime(start);
+    total += time[0] * 1e3 + time[1] / 1e6;
+    extend += result.stats.phases.extend;
+  }
+  console.log(extendThreads + ' thread(s): ' + (total / runs).toFixed(1) + ' ms per render, ' +
+    (extend / runs).toFixed(1) + ' ms extend');
+}
+
+[1, 2, 4, 8, 16].forEach(run);
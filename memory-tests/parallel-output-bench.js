@@ -0,0 +1,41 @@
+'use strict';
+
+var os = require('os');
+var sass = require('../');
+
+// renders a large utility stylesheet (many small top level rulesets
+// and media blocks) on one thread and on one thread per CPU
+var blocks = Number(process.argv[2]) || 20000;
+var threads = Number(process.argv[3]) || os.cpus().length;
+var runs = 5;
+
+var src = ['$space: 4px;'];
+for (var i = 0; i < blocks; i++) {
+  src.push('.m-' + i + ' { margin: $space * ' + (i % 16) + ' auto; }');
+  src.push('.c-' + i + ', .c-' + i + ':hover { color: mix(#036, #fc0, ' + (i % 100) + '%); }');
+  if (i % 10 === 0) {
+    src.push('@media (min-width: ' + (320 + i) + 'px) { .w-' + i + ' { width: ' + (i % 100) + '%; } }');
+  }
+}
+src = src.join('\n');
+// the runs only differ in the output phase
+var options = { data: src, outFile: 'out.css', sourceMap: true };
+
+function run(outputThreads) {
+  var total = 0;
+  var output = 0;
+  var bytes = 0;
+  for (var r = 0; r < runs; r++) {
+    var start = process.hrtime();
+    var result = sass.renderSync(Object.assign({ outputThreads: outputThreads }, options));
+    var time = process.hrtime(start);
+    total += time[0] * 1e3 + time[1] / 1e6;
+    output += result.stats.phases.output;
+    bytes = result.css.length;
+  }
+  console.log((outputThreads || 1) + ' thread(s): ' + (total / runs).toFixed(1) + ' ms per render, ' +
+    (output / runs).toFixed(1) + ' ms output (' + (bytes / 1e6).toFixed(1) + ' MB)');
+}
+
+run(0);
+run(threads);
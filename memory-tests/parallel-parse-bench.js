@@ -0,0 +1,43 @@
+'use strict';
+
+var fs = require('fs');
+var os = require('os');
+var path = require('path');
+var sass = require('../');
+
+// parses a wide import tree (an entry importing many independent
+// partials) on one thread and on one thread per CPU
+var partials = Number(process.argv[2]) || 150;
+var threads = Number(process.argv[3]) || os.cpus().length;
+var runs = 5;
+var dir = fs.mkdtempSync(path.join(os.tmpdir(), 'node-sass-parallel-'));
+
+var entry = ['@import "mixins";'];
+fs.writeFileSync(path.join(dir, '_mixins.scss'), '@mixin size($w, $h) { width: $w; height: $h; }\n');
+for (var i = 0; i < partials; i++) {
+  var rules = ['@import "mixins";'];
+  for (var j = 0; j < 50; j++) {
+    rules.push('.p' + i + '-' + j + ' { @include size(' + j + 'px, ' + i + 'px);' +
+      ' &:hover, .x & { color: darken(#369, ' + (j % 30) + '%); } }');
+  }
+  fs.writeFileSync(path.join(dir, '_p' + i + '.scss'), rules.join('\n') + '\n');
+  entry.push('@import "p' + i + '";');
+}
+fs.writeFileSync(path.join(dir, 'index.scss'), entry.join('\n') + '\n');
+
+function run(parseThreads) {
+  var total = 0;
+  var parse = 0;
+  for (var r = 0; r < runs; r++) {
+    var start = process.hrtime();
+    var result = sass.renderSync({ file: path.join(dir, 'index.scss'), parseThreads: parseThreads });
+    var time = process.hrtime(start);
+    total += time[0] * 1e3 + time[1] / 1e6;
+    parse += result.stats.phases.parse;
+  }
+  console.log((parseThreads || 1) + ' thread(s): ' + (total / runs).toFixed(1) + ' ms per render, ' +
+    (parse / runs).toFixed(1) + ' ms parsing');
+}
+
+run(0);
+run(threads);
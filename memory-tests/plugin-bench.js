@@ -0,0 +1,30 @@
+'use strict';
+
+var path = require('path');
+var sass = require('../');
+
+// time per call of the rem() function of the sample plugin
+// (make -C src/libsass plugin) and of the same function in JS
+var plugins = path.join(__dirname, '..', 'src', 'libsass', 'contrib', 'plugins');
+var calls = 5000;
+var src = '@for $i from 1 through ' + calls + ' { .a-#{$i} { width: rem($i * 1px); } }';
+
+function run(name, options) {
+  var start = process.hrtime();
+  var result = sass.renderSync(Object.assign({ data: src }, options));
+  var time = process.hrtime(start);
+  var ms = time[0] * 1e3 + time[1] / 1e6;
+  console.log(name + ': ' + ms.toFixed(1) + ' ms, ' +
+    (ms * 1e3 / calls).toFixed(2) + ' us per call (' +
+    result.stats.counters.customFunctionCalls + ' calls)');
+}
+
+run('plugin', { pluginPaths: [plugins] });
+
+run('javascript', {
+  functions: {
+    'rem($px, $base: 16px)': function(px, base) {
+      return new sass.types.Number(px.getValue() / base.getValue(), 'rem');
+    }
+  }
+});
@@ -0,0 +1,70 @@
+'use strict';
+
+var Emitter = require('events').EventEmitter;
+var fs = require('fs');
+var os = require('os');
+var path = require('path');
+var spawn = require('child_process').spawn;
+var spawnSync = require('child_process').spawnSync;
+var server = require('../lib/server');
+
+// compiles the same files through one CLI invocation per file, through
+// one --connect client per file, and by submitting all jobs to the
+// compile server from this process (what a persistent build driver does)
+var files = Number(process.argv[2]) || 500;
+var cli = path.join(__dirname, '..', 'bin', 'node-sass');
+var dir = fs.mkdtempSync(path.join(os.tmpdir(), 'node-sass-server-'));
+var socket = path.join(dir, 'server.sock');
+
+fs.writeFileSync(path.join(dir, '_theme.scss'),
+  '$primary: royalblue;\n@mixin button($c) { color: $c; border-color: darken($c, 10%); }\n');
+var entries = [];
+for (var i = 0; i < files; i++) {
+  var entry = path.join(dir, 'entry-' + i + '.scss');
+  fs.writeFileSync(entry, '@import "theme";\n.btn-' + i + ' { @include button($primary); width: ' + i + 'px; }\n');
+  entries.push(entry);
+}
+
+function time(name, fn) {
+  var start = process.hrtime();
+  return fn().then(function() {
+    var t = process.hrtime(start);
+    var ms = t[0] * 1e3 + t[1] / 1e6;
+    console.log(name + ': ' + ms.toFixed(0) + ' ms, ' + (ms / files).toFixed(2) + ' ms per file');
+  });
+}
+
+function separate(args) {
+  return new Promise(function(resolve) {
+    entries.forEach(function(entry) {
+      spawnSync(process.execPath, [cli, '-q'].concat(args, [entry, entry.replace(/\.scss$/, '.css')]));
+    });
+    resolve();
+  });
+}
+
+function submitted() {
+  return Promise.all(entries.map(function(entry) {
+    return new Promise(function(resolve, reject) {
+      var emitter = new Emitter();
+      emitter.on('done', resolve);
+      emitter.on('error', reject);
+      emitter.on('info', function() {});
+      server.submit(socket, { src: entry, dest: entry.replace(/\.scss$/, '.css'), quiet: true }, emitter);
+    });
+  }));
+}
+
+var resident = spawn(process.execPath, [cli, '--server', socket], { stdio: ['ignore', 'pipe', 'inherit'] });
+resident.stdout.once('data', function() {
+  time('separate invocations', function() { return separate([]); })
+    .then(function() { return time('--connect invocations', function() { return separate(['--connect', socket]); }); })
+    .then(function() { return time('submitted to the server', submitted); })
+    .then(function() {
+      resident.kill();
+    }, function(err) {
+      console.error(err);
+      resident.kill();
+      process.exitCode = 1;
+    });
+});
@@ -0,0 +1,43 @@
+'use strict';
+
+var sass = require('../');
+
+// compiles a themed stylesheet for many themes, once with a render per
+// theme and once with renderVariants
+var themes = Number(process.argv[2]) || 16;
+var blocks = 500;
+var runs = 3;
+
+var src = ['$brand: blue !default;', '$radius: 2px !default;',
+  '@mixin button($c) { color: $c; border: 1px solid darken($c, 10%); border-radius: $radius; }'];
+for (var i = 0; i < blocks; i++) {
+  src.push('.btn-' + i + ' { @include button(mix($brand, #' + (i % 10) + '0' + (i % 10) + '0' + (i % 10) + '0, ' + (i % 100) + '%)); }');
+  src.push('.card-' + i + ' .title { padding: $radius * ' + (i % 7) + '; &:hover { color: lighten($brand, ' + (i % 30) + '%); } }');
+}
+src = src.join('\n');
+
+var variants = [];
+for (var t = 0; t < themes; t++) {
+  variants.push({ prelude: '$brand: hsl(' + (t * 360 / themes) + ', 60%, 50%); $radius: ' + (t % 4) + 'px;' });
+}
+
+function time(fn) {
+  var total = 0;
+  for (var r = 0; r < runs; r++) {
+    var start = process.hrtime();
+    fn();
+    var elapsed = process.hrtime(start);
+    total += elapsed[0] * 1e3 + elapsed[1] / 1e6;
+  }
+  return (total / runs).toFixed(1) + ' ms';
+}
+
+console.log('renders:  ' + time(function() {
+  variants.forEach(function(variant) {
+    sass.renderSync({ data: variant.prelude + '\n' + src });
+  });
+}));
+
+console.log('variants: ' + time(function() {
+  sass.renderVariantsSync({ data: src, variants: variants });
+}));
@@ -12,26 +12,95 @@ Sass_Import_List sass_importer(const char* cur_path, Sass_Importer_Entry cb, str
   const char* prev_path = sass_import_get_abs_path(previous);
   CustomImporterBridge& bridge = *(static_cast<CustomImporterBridge*>(cookie));
 
+  Sass_Import_List imports;
+  if (bridge.cache && bridge.cache->get(bridge.id, cur_path, prev_path, &imports)) {
+    return imports;
+  }
+
   std::vector<void*> argv;
   argv.push_back((void*)cur_path);
   argv.push_back((void*)prev_path);
 
-  return bridge(argv);
+  imports = bridge(argv);
+  if (bridge.cache) {
+    bridge.cache->put(bridge.id, cur_path, prev_path, imports);
+  }
+  return imports;
 }
 
-union Sass_Value* sass_custom_function(const union Sass_Value* s_args, Sass_Function_Entry cb, struct Sass_Compiler* comp)
+union Sass_Value* sass_custom_function(union Sass_Value* s_args, Sass_Function_Entry cb, struct Sass_Compiler* comp)
 {
   void* cookie = sass_function_get_cookie(cb);
   CustomFunctionBridge& bridge = *(static_cast<CustomFunctionBridge*>(cookie));
 
+  // libsass hands the argument list over (see sass_make_function_take_args),
+  // so the arguments are taken out of it and wrapped for JS without copying
   std::vector<void*> argv;
   for (unsigned l = sass_list_get_length(s_args), i = 0; i < l; i++) {
     argv.push_back((void*)sass_list_get_value(s_args, i));
+    sass_list_set_value(s_args, i, sass_make_null());
   }
+  sass_delete_value(s_args);
 
   return bridge(argv);
 }
 
+// Reads the options of a variant, which only affect its evaluation and
+// output. Its strings are freed with the wrapper.
+void ExtractVariantOptions(v8::Local<v8::Object> options, sass_context_wrapper* ctx_w) {
+  Nan::HandleScope scope;
+
+  char* prelude = create_string(Nan::Get(options, Nan::New("prelude").ToLocalChecked()));
+  struct Sass_Variant_Context* vctx = sass_make_variant_context(prelude);
+  free(prelude);
+  ctx_w->variants.push_back(vctx);
+
+  struct Sass_Options* sass_options = sass_variant_context_get_options(vctx);
+
+  int indent_len = Nan::To<int32_t>(Nan::Get(options, Nan::New("indentWidth").ToLocalChecked()).ToLocalChecked()).FromJust();
+  char* indent = (char*)malloc(indent_len + 1);
+  strcpy(indent, std::string(
+    indent_len,
+    Nan::To<int32_t>(Nan::Get(options, Nan::New("indentType").ToLocalChecked()).ToLocalChecked()).FromJust() == 1 ? '\t' : ' '
+    ).c_str());
+  char* linefeed = create_string(Nan::Get(options, Nan::New("linefeed").ToLocalChecked()));
+  char* out_file = create_string(Nan::Get(options, Nan::New("outFile").ToLocalChecked()));
+  char* source_map = create_string(Nan::Get(options, Nan::New("sourceMap").ToLocalChecked()));
+  char* source_map_root = create_string(Nan::Get(options, Nan::New("sourceMapRoot").ToLocalChecked()));
+  // indent and linefeed are not copied by libsass
+  ctx_w->variant_strings.push_back(indent);
+  ctx_w->variant_strings.push_back(linefeed);
+
+  sass_option_set_output_path(sass_options, out_file);
+  sass_option_set_output_style(sass_options, (Sass_Output_Style)Nan::To<int32_t>(Nan::Get(options, Nan::New("style").ToLocalChecked()).ToLocalChecked()).FromJust());
+  sass_option_set_extend_threads(sass_options, Nan::To<int32_t>(Nan::Get(options, Nan::New("extendThreads").ToLocalChecked()).ToLocalChecked()).FromJust());
+  sass_option_set_output_threads(sass_options, Nan::To<int32_t>(Nan::Get(options, Nan::New("outputThreads").ToLocalChecked()).ToLocalChecked()).FromJust());
+  sass_option_set_source_comments(sass_options, Nan::To<bool>(Nan::Get(options, Nan::New("sourceComments").ToLocalChecked()).ToLocalChecked()).FromJust());
+  sass_option_set_omit_source_map_url(sass_options, Nan::To<bool>(Nan::Get(options, Nan::New("omitSourceMapUrl").ToLocalChecked()).ToLocalChecked()).FromJust());
+  sass_option_set_source_map_embed(sass_options, Nan::To<bool>(Nan::Get(options, Nan::New("sourceMapEmbed").ToLocalChecked()).ToLocalChecked()).FromJust());
+  sass_option_set_source_map_contents(sass_options, Nan::To<bool>(Nan::Get(options, Nan::New("sourceMapContents").ToLocalChecked()).ToLocalChecked()).FromJust());
+  sass_option_set_source_map_file(sass_options, source_map);
+  sass_option_set_source_map_root(sass_options, source_map_root);
+  sass_option_set_precision(sass_options, Nan::To<int32_t>(Nan::Get(options, Nan::New("precision").ToLocalChecked()).ToLocalChecked()).FromJust());
+  sass_option_set_indent(sass_options, indent);
+  sass_option_set_linefeed(sass_options, linefeed);
+
+  free(out_file);
+  free(source_map);
+  free(source_map_root);
+}
+
+// cached results are keyed by the id lib/index.js gives every importer
+// function, so renders with other importers (or in another order) can
+// share the cache, importers without an id are not cached
+void SetImporterCache(CustomImporterBridge* bridge, v8::Local<v8::Function> importer, std::shared_ptr<ImporterCache> cache) {
+  v8::Local<v8::Value> id = Nan::Get(importer, Nan::New("cacheId").ToLocalChecked()).ToLocalChecked();
+  if (cache && id->IsNumber()) {
+    bridge->cache = cache;
+    bridge->id = static_cast<size_t>(Nan::To<double>(id).FromJust());
+  }
+}
+
 int ExtractOptions(v8::Local<v8::Object> options, void* cptr, sass_context_wrapper* ctx_w, bool is_file, bool is_sync) {
   Nan::HandleScope scope;
 
@@ -60,6 +129,7 @@ int ExtractOptions(v8::Local<v8::Object> options, void* cptr, sass_context_wrapp
   struct Sass_Options* sass_options = sass_context_get_options(ctx);
 
   ctx_w->is_sync = is_sync;
+  ctx_w->parse_only = Nan::To<bool>(Nan::Get(options, Nan::New("parseOnly").ToLocalChecked()).ToLocalChecked()).FromJust();
 
   if (!is_sync) {
     ctx_w->request.data = ctx_w;
@@ -96,6 +166,7 @@ int ExtractOptions(v8::Local<v8::Object> options, void* cptr, sass_context_wrapp
 
   ctx_w->linefeed = create_string(Nan::Get(options, Nan::New("linefeed").ToLocalChecked()));
   ctx_w->include_path = create_string(Nan::Get(options, Nan::New("includePaths").ToLocalChecked()));
+  ctx_w->plugin_path = create_string(Nan::Get(options, Nan::New("pluginPaths").ToLocalChecked()));
   ctx_w->out_file = create_string(Nan::Get(options, Nan::New("outFile").ToLocalChecked()));
   ctx_w->source_map = create_string(Nan::Get(options, Nan::New("sourceMap").ToLocalChecked()));
   ctx_w->source_map_root = create_string(Nan::Get(options, Nan::New("sourceMapRoot").ToLocalChecked()));
@@ -103,6 +174,12 @@ int ExtractOptions(v8::Local<v8::Object> options, void* cptr, sass_context_wrapp
   sass_option_set_output_path(sass_options, ctx_w->out_file);
   sass_option_set_output_style(sass_options, (Sass_Output_Style)Nan::To<int32_t>(Nan::Get(options, Nan::New("style").ToLocalChecked()).ToLocalChecked()).FromJust());
   sass_option_set_is_indented_syntax_src(sass_options, Nan::To<bool>(Nan::Get(options, Nan::New("indentedSyntax").ToLocalChecked()).ToLocalChecked()).FromJust());
+  sass_option_set_memoize_functions(sass_options, Nan::To<bool>(Nan::Get(options, Nan::New("memoizeFunctions").ToLocalChecked()).ToLocalChecked()).FromJust());
+  sass_option_set_memoize_mixins(sass_options, Nan::To<bool>(Nan::Get(options, Nan::New("memoizeMixins").ToLocalChecked()).ToLocalChecked()).FromJust());
+  sass_option_set_parse_threads(sass_options, Nan::To<int32_t>(Nan::Get(options, Nan::New("parseThreads").ToLocalChecked()).ToLocalChecked()).FromJust());
+  sass_option_set_extend_threads(sass_options, Nan::To<int32_t>(Nan::Get(options, Nan::New("extendThreads").ToLocalChecked()).ToLocalChecked()).FromJust());
+  sass_option_set_output_threads(sass_options, Nan::To<int32_t>(Nan::Get(options, Nan::New("outputThreads").ToLocalChecked()).ToLocalChecked()).FromJust());
+  sass_option_set_profile_style(sass_options, (Sass_Profile_Style)Nan::To<int32_t>(Nan::Get(options, Nan::New("profileStyle").ToLocalChecked()).ToLocalChecked()).FromJust());
   sass_option_set_source_comments(sass_options, Nan::To<bool>(Nan::Get(options, Nan::New("sourceComments").ToLocalChecked()).ToLocalChecked()).FromJust());
   sass_option_set_omit_source_map_url(sass_options, Nan::To<bool>(Nan::Get(options, Nan::New("omitSourceMapUrl").ToLocalChecked()).ToLocalChecked()).FromJust());
   sass_option_set_source_map_embed(sass_options, Nan::To<bool>(Nan::Get(options, Nan::New("sourceMapEmbed").ToLocalChecked()).ToLocalChecked()).FromJust());
@@ -110,16 +187,22 @@ int ExtractOptions(v8::Local<v8::Object> options, void* cptr, sass_context_wrapp
   sass_option_set_source_map_file(sass_options, ctx_w->source_map);
   sass_option_set_source_map_root(sass_options, ctx_w->source_map_root);
   sass_option_set_include_path(sass_options, ctx_w->include_path);
+  sass_option_set_plugin_path(sass_options, ctx_w->plugin_path);
   sass_option_set_precision(sass_options, Nan::To<int32_t>(Nan::Get(options, Nan::New("precision").ToLocalChecked()).ToLocalChecked()).FromJust());
   sass_option_set_indent(sass_options, ctx_w->indent);
   sass_option_set_linefeed(sass_options, ctx_w->linefeed);
+  sass_option_set_time_limit(sass_options, (size_t)Nan::To<double>(Nan::Get(options, Nan::New("timeLimit").ToLocalChecked()).ToLocalChecked()).FromJust());
+  sass_option_set_node_limit(sass_options, (size_t)Nan::To<double>(Nan::Get(options, Nan::New("nodeLimit").ToLocalChecked()).ToLocalChecked()).FromJust());
+  sass_option_set_output_limit(sass_options, (size_t)Nan::To<double>(Nan::Get(options, Nan::New("outputLimit").ToLocalChecked()).ToLocalChecked()).FromJust());
 
   v8::Local<v8::Value> importer_callback = Nan::Get(options, Nan::New("importer").ToLocalChecked()).ToLocalChecked();
+  std::shared_ptr<ImporterCache> importer_cache = ImporterCacheWrapper::unwrap(Nan::Get(options, Nan::New("importerResultCache").ToLocalChecked()).ToLocalChecked());
 
   if (importer_callback->IsFunction()) {
     v8::Local<v8::Function> importer = importer_callback.As<v8::Function>();
 
     CustomImporterBridge *bridge = new CustomImporterBridge(importer, ctx_w->is_sync);
+    SetImporterCache(bridge, importer, importer_cache);
     ctx_w->importer_bridges.push_back(bridge);
 
     Sass_Importer_List c_importers = sass_make_importer_list(1);
@@ -135,6 +218,7 @@ int ExtractOptions(v8::Local<v8::Object> options, void* cptr, sass_context_wrapp
       v8::Local<v8::Function> callback = v8::Local<v8::Function>::Cast(Nan::Get(importers, static_cast<uint32_t>(i)).ToLocalChecked());
 
       CustomImporterBridge *bridge = new CustomImporterBridge(callback, ctx_w->is_sync);
+      SetImporterCache(bridge, callback, importer_cache);
       ctx_w->importer_bridges.push_back(bridge);
 
       c_importers[i] = sass_make_importer(sass_importer, importers->Length() - i - 1, bridge);
@@ -159,17 +243,41 @@ int ExtractOptions(v8::Local<v8::Object> options, void* cptr, sass_context_wrapp
       ctx_w->function_bridges.push_back(bridge);
 
       char* sig = create_string(signature);
-      Sass_Function_Entry fn = sass_make_function(sig, sass_custom_function, bridge);
+      Sass_Function_Entry fn = sass_make_function_take_args(sig, sass_custom_function, bridge);
       free(sig);
+      // results of pure functions are cached by libsass, which saves the
+      // round trip to the main thread for repeated calls
+      v8::Local<v8::Value> pure = Nan::Get(callback, Nan::New("pure").ToLocalChecked()).ToLocalChecked();
+      sass_function_set_pure(fn, Nan::To<bool>(pure).FromJust());
       sass_function_set_list_entry(fn_list, i, fn);
     }
 
     sass_option_set_c_functions(sass_options, fn_list);
   }
+
+  v8::Local<v8::Value> variants_ = Nan::Get(options, Nan::New("variants").ToLocalChecked()).ToLocalChecked();
+
+  if (variants_->IsArray()) {
+    v8::Local<v8::Array> variants = variants_.As<v8::Array>();
+    v8::Local<v8::Array> results = Nan::New<v8::Array>(variants->Length());
+
+    for (uint32_t i = 0; i < variants->Length(); ++i) {
+      v8::Local<v8::Object> variant = Nan::To<v8::Object>(Nan::Get(variants, i).ToLocalChecked()).ToLocalChecked();
+      v8::Local<v8::Value> variant_result = Nan::Get(variant, Nan::New("result").ToLocalChecked()).ToLocalChecked();
+      if (!variant_result->IsObject()) {
+        Nan::ThrowTypeError("\"result\" element of a variant is not an object");
+        return -1;
+      }
+      Nan::Set(results, i, variant_result);
+      ExtractVariantOptions(variant, ctx_w);
+    }
+
+    ctx_w->variant_results.Reset(results);
+  }
   return 0;
 }
 
-void GetStats(sass_context_wrapper* ctx_w, Sass_Context* ctx) {
+void GetStats(v8::Local<v8::Object> result, Sass_Context* ctx) {
   Nan::HandleScope scope;
 
   char** included_files = sass_context_get_included_files(ctx);
@@ -181,8 +289,64 @@ void GetStats(sass_context_wrapper* ctx_w, Sass_Context* ctx) {
     }
   }
 
-  v8::Local<v8::Object> result = Nan::New(ctx_w->result);
-  assert(result->IsObject());
+  v8::Local<v8::Object> call_cache = Nan::New<v8::Object>();
+  Nan::Set(call_cache, Nan::New("hits").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(sass_context_get_call_cache_hits(ctx))));
+  Nan::Set(call_cache, Nan::New("misses").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(sass_context_get_call_cache_misses(ctx))));
+  Nan::Set(call_cache, Nan::New("pureFunctions").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(sass_context_get_pure_functions(ctx))));
+  Nan::Set(call_cache, Nan::New("impureFunctions").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(sass_context_get_impure_functions(ctx))));
+
+  v8::Local<v8::Object> mixin_cache = Nan::New<v8::Object>();
+  Nan::Set(mixin_cache, Nan::New("hits").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(sass_context_get_mixin_cache_hits(ctx))));
+  Nan::Set(mixin_cache, Nan::New("misses").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(sass_context_get_mixin_cache_misses(ctx))));
+
+  v8::Local<v8::Object> phases = Nan::New<v8::Object>();
+  Nan::Set(phases, Nan::New("parse").ToLocalChecked(), Nan::New<v8::Number>(sass_context_get_parse_time(ctx)));
+  Nan::Set(phases, Nan::New("expand").ToLocalChecked(), Nan::New<v8::Number>(sass_context_get_expand_time(ctx)));
+  Nan::Set(phases, Nan::New("checkNesting").ToLocalChecked(), Nan::New<v8::Number>(sass_context_get_check_nesting_time(ctx)));
+  Nan::Set(phases, Nan::New("cssize").ToLocalChecked(), Nan::New<v8::Number>(sass_context_get_cssize_time(ctx)));
+  Nan::Set(phases, Nan::New("extend").ToLocalChecked(), Nan::New<v8::Number>(sass_context_get_extend_time(ctx)));
+  Nan::Set(phases, Nan::New("removePlaceholders").ToLocalChecked(), Nan::New<v8::Number>(sass_context_get_remove_placeholders_time(ctx)));
+  Nan::Set(phases, Nan::New("output").ToLocalChecked(), Nan::New<v8::Number>(sass_context_get_output_time(ctx)));
+
+  v8::Local<v8::Object> parse_times = Nan::New<v8::Object>();
+  char** parsed_files = sass_context_get_parsed_files(ctx);
+  double* parse_time = sass_context_get_parse_times(ctx);
+  if (parsed_files) {
+    for (int i = 0; parsed_files[i] != nullptr; ++i) {
+      Nan::Set(parse_times, Nan::New<v8::String>(parsed_files[i]).ToLocalChecked(), Nan::New<v8::Number>(parse_time[i]));
+    }
+  }
+
+  // every parsed file with the files it imports directly
+  v8::Local<v8::Object> imports = Nan::New<v8::Object>();
+  if (parsed_files) {
+    for (int i = 0; parsed_files[i] != nullptr; ++i) {
+      Nan::Set(imports, Nan::New<v8::String>(parsed_files[i]).ToLocalChecked(), Nan::New<v8::Array>());
+    }
+  }
+  char** import_parents = sass_context_get_import_parents(ctx);
+  char** import_files = sass_context_get_import_files(ctx);
+  if (import_parents) {
+    for (int i = 0; import_parents[i] != nullptr; ++i) {
+      v8::Local<v8::String> parent = Nan::New<v8::String>(import_parents[i]).ToLocalChecked();
+      v8::Local<v8::Value> children = Nan::Get(imports, parent).ToLocalChecked();
+      if (!children->IsArray()) {
+        children = Nan::New<v8::Array>();
+        Nan::Set(imports, parent, children);
+      }
+      v8::Local<v8::Array> list = children.As<v8::Array>();
+      Nan::Set(list, list->Length(), Nan::New<v8::String>(import_files[i]).ToLocalChecked());
+    }
+  }
+
+  v8::Local<v8::Object> counters = Nan::New<v8::Object>();
+  Nan::Set(counters, Nan::New("functionCalls").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(sass_context_get_function_calls(ctx))));
+  Nan::Set(counters, Nan::New("customFunctionCalls").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(sass_context_get_c_function_calls(ctx))));
+  Nan::Set(counters, Nan::New("customFunctionCacheHits").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(sass_context_get_c_function_cache_hits(ctx))));
+  Nan::Set(counters, Nan::New("mixinIncludes").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(sass_context_get_mixin_includes(ctx))));
+  Nan::Set(counters, Nan::New("extendLookups").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(sass_context_get_extend_lookups(ctx))));
+  Nan::Set(counters, Nan::New("allocatedNodes").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(sass_context_get_allocated_nodes(ctx))));
+  Nan::Set(counters, Nan::New("outputBytes").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(sass_context_get_output_bytes(ctx))));
 
   v8::Local<v8::Value> stats = Nan::Get(
     result,
@@ -194,34 +358,102 @@ void GetStats(sass_context_wrapper* ctx_w, Sass_Context* ctx) {
       Nan::New("includedFiles").ToLocalChecked(),
       arr
     );
+    Nan::Set(
+      stats.As<v8::Object>(),
+      Nan::New("callCache").ToLocalChecked(),
+      call_cache
+    );
+    Nan::Set(
+      stats.As<v8::Object>(),
+      Nan::New("mixinCache").ToLocalChecked(),
+      mixin_cache
+    );
+    Nan::Set(
+      stats.As<v8::Object>(),
+      Nan::New("phases").ToLocalChecked(),
+      phases
+    );
+    Nan::Set(
+      stats.As<v8::Object>(),
+      Nan::New("parseTimes").ToLocalChecked(),
+      parse_times
+    );
+    Nan::Set(
+      stats.As<v8::Object>(),
+      Nan::New("imports").ToLocalChecked(),
+      imports
+    );
+    Nan::Set(
+      stats.As<v8::Object>(),
+      Nan::New("counters").ToLocalChecked(),
+      counters
+    );
   } else {
     Nan::ThrowTypeError("\"result.stats\" element is not an object");
   }
 }
 
+void SetOutput(v8::Local<v8::Object> result, Sass_Context* ctx) {
+  Nan::HandleScope scope;
+
+  const char* css = sass_context_get_output_string(ctx);
+  const char* map = sass_context_get_source_map_string(ctx);
+  const char* profile = sass_context_get_profile_string(ctx);
+
+  // nothing is rendered when only the imports were resolved
+  if (css) {
+    Nan::Set(result, Nan::New("css").ToLocalChecked(), Nan::CopyBuffer(css, static_cast<uint32_t>(strlen(css))).ToLocalChecked());
+  }
+
+  GetStats(result, ctx);
+
+  if (map) {
+    Nan::Set(result, Nan::New("map").ToLocalChecked(), Nan::CopyBuffer(map, static_cast<uint32_t>(strlen(map))).ToLocalChecked());
+  }
+
+  if (profile) {
+    Nan::Set(result, Nan::New("profile").ToLocalChecked(), Nan::New<v8::String>(profile).ToLocalChecked());
+  }
+}
+
+// The context that failed: the render or else the first failed variant,
+// whose index is set on the result
+Sass_Context* GetFailedContext(sass_context_wrapper* ctx_w, Sass_Context* ctx) {
+  if (sass_context_get_error_status(ctx)) {
+    return ctx;
+  }
+  for (size_t i = 0; i < ctx_w->variants.size(); ++i) {
+    Sass_Context* variant = sass_variant_context_get_context(ctx_w->variants[i]);
+    if (sass_context_get_error_status(variant)) {
+      Nan::Set(Nan::New(ctx_w->result), Nan::New("variant").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(i)));
+      return variant;
+    }
+  }
+  return 0;
+}
+
 int GetResult(sass_context_wrapper* ctx_w, Sass_Context* ctx, bool is_sync = false) {
   Nan::HandleScope scope;
   v8::Local<v8::Object> result;
 
-  int status = sass_context_get_error_status(ctx);
+  Sass_Context* failed = GetFailedContext(ctx_w, ctx);
+  int status = failed ? sass_context_get_error_status(failed) : 0;
 
   result = Nan::New(ctx_w->result);
   assert(result->IsObject());
 
-  if (status == 0) {
-    const char* css = sass_context_get_output_string(ctx);
-    const char* map = sass_context_get_source_map_string(ctx);
-
-    Nan::Set(result, Nan::New("css").ToLocalChecked(), Nan::CopyBuffer(css, static_cast<uint32_t>(strlen(css))).ToLocalChecked());
-
-    GetStats(ctx_w, ctx);
-
-    if (map) {
-      Nan::Set(result, Nan::New("map").ToLocalChecked(), Nan::CopyBuffer(map, static_cast<uint32_t>(strlen(map))).ToLocalChecked());
+  if (status == 0 && !ctx_w->variants.empty()) {
+    v8::Local<v8::Array> results = Nan::New(ctx_w->variant_results);
+    for (uint32_t i = 0; i < ctx_w->variants.size(); ++i) {
+      v8::Local<v8::Object> variant_result = Nan::To<v8::Object>(Nan::Get(results, i).ToLocalChecked()).ToLocalChecked();
+      SetOutput(variant_result, sass_variant_context_get_context(ctx_w->variants[i]));
     }
   }
+  else if (status == 0) {
+    SetOutput(result, ctx);
+  }
   else if (is_sync) {
-    Nan::Set(result, Nan::New("error").ToLocalChecked(), Nan::New<v8::String>(sass_context_get_error_json(ctx)).ToLocalChecked());
+    Nan::Set(result, Nan::New("error").ToLocalChecked(), Nan::New<v8::String>(sass_context_get_error_json(failed)).ToLocalChecked());
   }
 
   return status;
@@ -257,7 +489,7 @@ void MakeCallback(uv_work_t* req) {
   }
   else if (ctx_w->error_callback) {
     // if error, do callback(error)
-    const char* err = sass_context_get_error_json(ctx);
+    const char* err = sass_context_get_error_json(GetFailedContext(ctx_w, ctx));
     v8::Local<v8::Value> argv[] = {
       Nan::New<v8::String>(err).ToLocalChecked()
     };
@@ -270,6 +502,37 @@ void MakeCallback(uv_work_t* req) {
   sass_free_context_wrapper(ctx_w);
 }
 
+// The handle of an async render, its cancel() stops the compile at
+// the next checkpoint (it fails with status 6). It points to the
+// wrapper until that is freed, later calls do nothing.
+static thread_local Nan::Persistent<v8::Function> render_handle_constructor;
+
+NAN_METHOD(new_render_handle) {
+  info.GetReturnValue().Set(info.This());
+}
+
+NAN_METHOD(cancel_render) {
+  void* ctx_w = Nan::GetInternalFieldPointer(info.This(), 0);
+  if (ctx_w) {
+    cancel_it(static_cast<sass_context_wrapper*>(ctx_w));
+  }
+}
+
+v8::Local<v8::Object> MakeRenderHandle(sass_context_wrapper* ctx_w) {
+  if (render_handle_constructor.IsEmpty()) {
+    v8::Local<v8::FunctionTemplate> tpl = Nan::New<v8::FunctionTemplate>(new_render_handle);
+    tpl->SetClassName(Nan::New("RenderHandle").ToLocalChecked());
+    tpl->InstanceTemplate()->SetInternalFieldCount(1);
+    Nan::SetPrototypeMethod(tpl, "cancel", cancel_render);
+    render_handle_constructor.Reset(Nan::GetFunction(tpl).ToLocalChecked());
+  }
+
+  v8::Local<v8::Object> handle = Nan::NewInstance(Nan::New(render_handle_constructor)).ToLocalChecked();
+  Nan::SetInternalFieldPointer(handle, 0, ctx_w);
+  ctx_w->handle.Reset(handle);
+  return handle;
+}
+
 NAN_METHOD(render) {
 
   v8::Local<v8::Object> options = Nan::To<v8::Object>(info[0]).ToLocalChecked();
@@ -281,9 +544,10 @@ NAN_METHOD(render) {
 
   if (ExtractOptions(options, dctx, ctx_w, false, false) >= 0) {
 
-    int status = uv_queue_work(uv_default_loop(), &ctx_w->request, compile_it, (uv_after_work_cb)MakeCallback);
+    int status = uv_queue_work(Nan::GetCurrentEventLoop(), &ctx_w->request, compile_it, (uv_after_work_cb)MakeCallback);
 
     assert(status == 0);
+    info.GetReturnValue().Set(MakeRenderHandle(ctx_w));
   }
 }
 
@@ -297,7 +561,11 @@ NAN_METHOD(render_sync) {
   int result = -1;
 
   if ((result = ExtractOptions(options, dctx, ctx_w, false, true)) >= 0) {
-    compile_data(dctx);
+    if (!ctx_w->variants.empty()) {
+      compile_variants(ctx_w);
+    } else {
+      ctx_w->parse_only ? parse_data(dctx) : compile_data(dctx);
+    }
     result = GetResult(ctx_w, ctx, true);
   }
 
@@ -317,8 +585,9 @@ NAN_METHOD(render_file) {
 
   if (ExtractOptions(options, fctx, ctx_w, true, false) >= 0) {
 
-    int status = uv_queue_work(uv_default_loop(), &ctx_w->request, compile_it, (uv_after_work_cb)MakeCallback);
+    int status = uv_queue_work(Nan::GetCurrentEventLoop(), &ctx_w->request, compile_it, (uv_after_work_cb)MakeCallback);
     assert(status == 0);
+    info.GetReturnValue().Set(MakeRenderHandle(ctx_w));
   }
 }
 
@@ -332,7 +601,11 @@ NAN_METHOD(render_file_sync) {
   int result = -1;
 
   if ((result = ExtractOptions(options, fctx, ctx_w, true, true)) >= 0) {
-    compile_file(fctx);
+    if (!ctx_w->variants.empty()) {
+      compile_variants(ctx_w);
+    } else {
+      ctx_w->parse_only ? parse_file(fctx) : compile_file(fctx);
+    }
     result = GetResult(ctx_w, ctx, true);
   };
 
@@ -346,13 +619,67 @@ NAN_METHOD(libsass_version) {
   info.GetReturnValue().Set(Nan::New<v8::String>(libsass_version()).ToLocalChecked());
 }
 
+NAN_METHOD(heap_tracking) {
+  sass_heap_set_tracking(Nan::To<bool>(info[0]).FromJust());
+}
+
+NAN_METHOD(heap_stats) {
+  v8::Local<v8::Object> stats = Nan::New<v8::Object>();
+  v8::Local<v8::Object> types = Nan::New<v8::Object>();
+  double live = 0, total = 0, bytes = 0;
+
+  for (size_t i = 0, count = sass_heap_type_count(); i < count; ++i) {
+    v8::Local<v8::Object> type = Nan::New<v8::Object>();
+    double type_live = static_cast<double>(sass_heap_type_live(i));
+    double type_total = static_cast<double>(sass_heap_type_total(i));
+    double type_bytes = type_live * sass_heap_type_size(i);
+    Nan::Set(type, Nan::New("live").ToLocalChecked(), Nan::New<v8::Number>(type_live));
+    Nan::Set(type, Nan::New("total").ToLocalChecked(), Nan::New<v8::Number>(type_total));
+    Nan::Set(type, Nan::New("bytes").ToLocalChecked(), Nan::New<v8::Number>(type_bytes));
+    Nan::Set(types, Nan::New(sass_heap_type_name(i)).ToLocalChecked(), type);
+    live += type_live;
+    total += type_total;
+    bytes += type_bytes;
+  }
+
+  Nan::Set(stats, Nan::New("live").ToLocalChecked(), Nan::New<v8::Number>(live));
+  Nan::Set(stats, Nan::New("total").ToLocalChecked(), Nan::New<v8::Number>(total));
+  Nan::Set(stats, Nan::New("bytes").ToLocalChecked(), Nan::New<v8::Number>(bytes));
+  Nan::Set(stats, Nan::New("types").ToLocalChecked(), types);
+  info.GetReturnValue().Set(stats);
+}
+
+// The addon is loaded once per isolate (main thread and every worker
+// thread), so handles cached by the bridges and sass types are released
+// when the environment of that isolate is torn down. The hook is added
+// once per environment, a later environment on the same thread adds it
+// again.
+static thread_local bool cleanup_registered = false;
+
+static void cleanup(void*) {
+  cleanup_registered = false;
+  render_handle_constructor.Reset();
+  SassTypes::Factory::cleanup();
+  ImporterCacheWrapper::cleanup();
+  CustomFunctionBridge::cleanup();
+  CustomImporterBridge::cleanup();
+}
+
 NAN_MODULE_INIT(RegisterModule) {
   Nan::SetMethod(target, "render", render);
   Nan::SetMethod(target, "renderSync", render_sync);
   Nan::SetMethod(target, "renderFile", render_file);
   Nan::SetMethod(target, "renderFileSync", render_file_sync);
   Nan::SetMethod(target, "libsassVersion", libsass_version);
+  Nan::SetMethod(target, "setHeapTracking", heap_tracking);
+  Nan::SetMethod(target, "getHeapStats", heap_stats);
+  Nan::Set(target, Nan::New("ImporterResultCache").ToLocalChecked(), ImporterCacheWrapper::get_constructor());
   SassTypes::Factory::initExports(target);
+
+  if (!cleanup_registered) {
+    node::AddEnvironmentCleanupHook(v8::Isolate::GetCurrent(), cleanup, NULL);
+    cleanup_registered = true;
+  }
 }
 
-NODE_MODULE(binding, RegisterModule);
+NAN_MODULE_WORKER_ENABLED(binding, RegisterModule)
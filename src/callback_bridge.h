@@ -17,6 +17,9 @@ class CallbackBridge {
     // Executes the callback
     T operator()(std::vector<void*>);
 
+    // Releases the wrapper constructor of the current isolate
+    static void cleanup();
+
   protected:
     // We will expose a bridge object to the JS callback that wraps this instance so we don't loose context.
     // This is the V8 constructor for such objects.
@@ -24,7 +27,8 @@ class CallbackBridge {
     static void async_gone(uv_handle_t *handle);
     static NAN_METHOD(New);
     static NAN_METHOD(ReturnCallback);
-    static Nan::Persistent<v8::Function> wrapper_constructor;
+    // One per isolate, and every isolate runs on its own thread
+    static thread_local Nan::Persistent<v8::Function> wrapper_constructor;
     Nan::Persistent<v8::Object> wrapper;
 
     // The callback that will get called in the main thread after the worker thread used for the sass
@@ -52,7 +56,7 @@ class CallbackBridge {
 };
 
 template <typename T, typename L>
-Nan::Persistent<v8::Function> CallbackBridge<T, L>::wrapper_constructor;
+thread_local Nan::Persistent<v8::Function> CallbackBridge<T, L>::wrapper_constructor;
 
 template <typename T, typename L>
 CallbackBridge<T, L>::CallbackBridge(v8::Local<v8::Function> callback, bool is_sync) : callback(new Nan::Callback(callback)), is_sync(is_sync) {
@@ -66,7 +70,7 @@ CallbackBridge<T, L>::CallbackBridge(v8::Local<v8::Function> callback, bool is_s
   if (!is_sync) {
     this->async = new uv_async_t;
     this->async->data = (void*) this;
-    uv_async_init(uv_default_loop(), this->async, (uv_async_cb) dispatched_async_uv_callback);
+    uv_async_init(Nan::GetCurrentEventLoop(), this->async, (uv_async_cb) dispatched_async_uv_callback);
     this->async_resource = new Nan::AsyncResource("node-sass:CallbackBridge");
   }
 
@@ -215,6 +219,11 @@ Nan::MaybeLocal<v8::Function> CallbackBridge<T, L>::get_wrapper_constructor() {
   return Nan::New(wrapper_constructor);
 }
 
+template <typename T, typename L>
+void CallbackBridge<T, L>::cleanup() {
+  wrapper_constructor.Reset();
+}
+
 template <typename T, typename L>
 NAN_METHOD(CallbackBridge<T COMMA L>::New) {
   info.GetReturnValue().Set(info.This());
@@ -18,7 +18,8 @@ std::vector<v8::Local<v8::Value>> CustomFunctionBridge::pre_process_args(std::ve
 
   for (void* value : in) {
     Sass_Value* x = static_cast<Sass_Value*>(value);
-    SassTypes::Value* y = SassTypes::Factory::create(x);
+    // the bridge owns the arguments, see sass_custom_function
+    SassTypes::Value* y = SassTypes::Factory::create(x, SassTypes::ValueRoot(x, sass_delete_value));
 
     argv.push_back(y->get_js_object());
   }
@@ -5,12 +5,18 @@
 #include <sass/functions.h>
 #include <sass/values.h>
 #include "callback_bridge.h"
+#include "importer_cache.h"
 
 typedef Sass_Import_List SassImportList;
 
 class CustomImporterBridge : public CallbackBridge<SassImportList> {
   public:
-    CustomImporterBridge(v8::Local<v8::Function> cb, bool is_sync) : CallbackBridge<SassImportList>(cb, is_sync) {}
+    CustomImporterBridge(v8::Local<v8::Function> cb, bool is_sync) : CallbackBridge<SassImportList>(cb, is_sync), id(0) {}
+
+    // results shared across renders (optional) and the id of the
+    // importer function, which is part of the cache key
+    std::shared_ptr<ImporterCache> cache;
+    size_t id;
 
   private:
     SassImportList post_process_return_value(v8::Local<v8::Value>) const;
@@ -0,0 +1,195 @@
+#include <nan.h>
+#include <string.h>
+#include "importer_cache.h"
+#include "create_string.h"
+
+ImporterCache::ImporterCache(size_t max_entries)
+: max_entries(max_entries), hit_count(0), miss_count(0) { }
+
+std::string ImporterCache::make_key(size_t importer, const char* url, const char* prev) {
+  std::string key(std::to_string(importer));
+  key += '\n';
+  key += url ? url : "";
+  key += '\n';
+  key += prev ? prev : "";
+  return key;
+}
+
+bool ImporterCache::get(size_t importer, const char* url, const char* prev, Sass_Import_List* imports) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = index.find(make_key(importer, url, prev));
+  if (it == index.end()) {
+    ++ miss_count;
+    return false;
+  }
+  ++ hit_count;
+  // move to the front of the list
+  entries.splice(entries.begin(), entries, it->second);
+  const Entry& entry = entries.front();
+  if (entry.declined) {
+    *imports = 0;
+    return true;
+  }
+  // libsass takes over the returned buffers
+  *imports = sass_make_import_list(entry.imports.size());
+  for (size_t i = 0; i < entry.imports.size(); ++i) {
+    const Import& import = entry.imports[i];
+    (*imports)[i] = sass_make_import_entry(
+      import.has_path ? import.path.c_str() : 0,
+      import.has_source ? sass_copy_c_string(import.source.c_str()) : 0,
+      import.has_srcmap ? sass_copy_c_string(import.srcmap.c_str()) : 0
+    );
+  }
+  return true;
+}
+
+void ImporterCache::put(size_t importer, const char* url, const char* prev, Sass_Import_List imports) {
+  Entry entry;
+  entry.key = make_key(importer, url, prev);
+  entry.url = url ? url : "";
+  entry.prev = prev ? prev : "";
+  entry.declined = imports == 0;
+  for (Sass_Import_List it = imports; it && *it; ++it) {
+    // errors are reported again on the next call
+    if (sass_import_get_error_message(*it)) return;
+    const char* path = sass_import_get_abs_path(*it);
+    const char* source = sass_import_get_source(*it);
+    const char* srcmap = sass_import_get_srcmap(*it);
+    entry.imports.push_back({
+      path != 0, path ? path : "",
+      source != 0, source ? source : "",
+      srcmap != 0, srcmap ? srcmap : ""
+    });
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = index.find(entry.key);
+  if (it != index.end()) {
+    entries.erase(it->second);
+    index.erase(it);
+  }
+  if (max_entries == 0) return;
+  while (entries.size() >= max_entries) {
+    index.erase(entries.back().key);
+    entries.pop_back();
+  }
+  entries.push_front(entry);
+  index[entries.front().key] = entries.begin();
+}
+
+void ImporterCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  entries.clear();
+  index.clear();
+}
+
+size_t ImporterCache::remove(const std::string& url, const char* prev) {
+  std::lock_guard<std::mutex> lock(mutex);
+  size_t removed = 0;
+  for (auto it = entries.begin(); it != entries.end(); ) {
+    if (it->url == url && (!prev || it->prev == prev)) {
+      index.erase(it->key);
+      it = entries.erase(it);
+      ++ removed;
+    }
+    else {
+      ++ it;
+    }
+  }
+  return removed;
+}
+
+size_t ImporterCache::size() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return entries.size();
+}
+
+size_t ImporterCache::hits() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return hit_count;
+}
+
+size_t ImporterCache::misses() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return miss_count;
+}
+
+thread_local Nan::Persistent<v8::FunctionTemplate> ImporterCacheWrapper::constructor_template;
+thread_local Nan::Persistent<v8::Function> ImporterCacheWrapper::constructor;
+
+ImporterCacheWrapper::ImporterCacheWrapper(size_t max_entries)
+: cache(std::make_shared<ImporterCache>(max_entries)) { }
+
+v8::Local<v8::Function> ImporterCacheWrapper::get_constructor() {
+  Nan::EscapableHandleScope scope;
+  if (constructor.IsEmpty()) {
+    v8::Local<v8::FunctionTemplate> tpl = Nan::New<v8::FunctionTemplate>(New);
+    tpl->SetClassName(Nan::New("ImporterResultCache").ToLocalChecked());
+    tpl->InstanceTemplate()->SetInternalFieldCount(1);
+    Nan::SetPrototypeMethod(tpl, "clear", Clear);
+    Nan::SetPrototypeMethod(tpl, "delete", Delete);
+    Nan::SetPrototypeMethod(tpl, "getStats", GetStats);
+    constructor_template.Reset(tpl);
+    constructor.Reset(Nan::GetFunction(tpl).ToLocalChecked());
+  }
+  return scope.Escape(Nan::New(constructor));
+}
+
+std::shared_ptr<ImporterCache> ImporterCacheWrapper::unwrap(v8::Local<v8::Value> value) {
+  if (constructor_template.IsEmpty() || !Nan::New(constructor_template)->HasInstance(value)) {
+    return std::shared_ptr<ImporterCache>();
+  }
+  return Nan::ObjectWrap::Unwrap<ImporterCacheWrapper>(value.As<v8::Object>())->cache;
+}
+
+void ImporterCacheWrapper::cleanup() {
+  constructor.Reset();
+  constructor_template.Reset();
+}
+
+NAN_METHOD(ImporterCacheWrapper::New) {
+  if (!info.IsConstructCall()) {
+    return Nan::ThrowTypeError("Use the new operator to create an ImporterResultCache");
+  }
+
+  size_t max_entries = 1000;
+  if (info.Length() >= 1 && info[0]->IsObject()) {
+    v8::Local<v8::Object> options = info[0].As<v8::Object>();
+    v8::Local<v8::Value> max = Nan::Get(options, Nan::New("maxEntries").ToLocalChecked()).ToLocalChecked();
+    if (!max->IsUndefined()) {
+      if (!max->IsNumber() || Nan::To<double>(max).FromJust() < 0) {
+        return Nan::ThrowTypeError("maxEntries should be a positive integer");
+      }
+      max_entries = static_cast<size_t>(Nan::To<double>(max).FromJust());
+    }
+  }
+
+  ImporterCacheWrapper* wrapper = new ImporterCacheWrapper(max_entries);
+  wrapper->Wrap(info.This());
+  info.GetReturnValue().Set(info.This());
+}
+
+NAN_METHOD(ImporterCacheWrapper::Clear) {
+  Nan::ObjectWrap::Unwrap<ImporterCacheWrapper>(info.This())->cache->clear();
+}
+
+NAN_METHOD(ImporterCacheWrapper::Delete) {
+  if (info.Length() < 1 || !info[0]->IsString()) {
+    return Nan::ThrowTypeError("Expected the url as first argument");
+  }
+  char* url = create_string(info[0]);
+  char* prev = info.Length() >= 2 ? create_string(info[1]) : 0;
+  size_t removed = Nan::ObjectWrap::Unwrap<ImporterCacheWrapper>(info.This())->cache->remove(url, prev);
+  free(url);
+  free(prev);
+  info.GetReturnValue().Set(Nan::New<v8::Number>(static_cast<double>(removed)));
+}
+
+NAN_METHOD(ImporterCacheWrapper::GetStats) {
+  std::shared_ptr<ImporterCache> cache = Nan::ObjectWrap::Unwrap<ImporterCacheWrapper>(info.This())->cache;
+  v8::Local<v8::Object> stats = Nan::New<v8::Object>();
+  Nan::Set(stats, Nan::New("entries").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(cache->size())));
+  Nan::Set(stats, Nan::New("hits").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(cache->hits())));
+  Nan::Set(stats, Nan::New("misses").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(cache->misses())));
+  info.GetReturnValue().Set(stats);
+}
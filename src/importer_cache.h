@@ -0,0 +1,88 @@
+#ifndef IMPORTER_CACHE_H
+#define IMPORTER_CACHE_H
+
+#include <list>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <nan.h>
+#include <sass/functions.h>
+
+// Results of custom importers (paths and sources, not parsed sheets),
+// keyed by importer, url and previous path and shared by all renders
+// given the same cache. Lookups happen on the compile thread, so a hit
+// doesn't call into JavaScript, but the import is still parsed again.
+// Least recently used results are dropped first once the cache is full.
+class ImporterCache {
+  public:
+    ImporterCache(size_t max_entries);
+
+    // returns a fresh copy of the cached imports (NULL if the importer
+    // declined), or false if the call is not cached yet
+    bool get(size_t importer, const char* url, const char* prev, Sass_Import_List* imports);
+    // remembers a copy of the imports, unless one of them failed
+    void put(size_t importer, const char* url, const char* prev, Sass_Import_List imports);
+
+    void clear();
+    // drops the results for url (only those for prev if given)
+    size_t remove(const std::string& url, const char* prev);
+
+    size_t size();
+    size_t hits();
+    size_t misses();
+
+  private:
+    struct Import {
+      bool has_path;
+      std::string path;
+      bool has_source;
+      std::string source;
+      bool has_srcmap;
+      std::string srcmap;
+    };
+
+    struct Entry {
+      std::string key;
+      std::string url;
+      std::string prev;
+      std::vector<Import> imports;
+      bool declined;
+    };
+
+    static std::string make_key(size_t importer, const char* url, const char* prev);
+
+    std::mutex mutex;
+    size_t max_entries;
+    // most recently used first
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    size_t hit_count;
+    size_t miss_count;
+};
+
+// The JS side of an ImporterCache, passed to renders as `importerCache`
+class ImporterCacheWrapper : public Nan::ObjectWrap {
+  public:
+    static v8::Local<v8::Function> get_constructor();
+    // returns the cache wrapped by value, if it is one
+    static std::shared_ptr<ImporterCache> unwrap(v8::Local<v8::Value> value);
+    // releases the constructor of the current isolate
+    static void cleanup();
+
+    static NAN_METHOD(New);
+    static NAN_METHOD(Clear);
+    static NAN_METHOD(Delete);
+    static NAN_METHOD(GetStats);
+
+  private:
+    ImporterCacheWrapper(size_t max_entries);
+
+    std::shared_ptr<ImporterCache> cache;
+
+    static thread_local Nan::Persistent<v8::FunctionTemplate> constructor_template;
+    static thread_local Nan::Persistent<v8::Function> constructor;
+};
+
+#endif
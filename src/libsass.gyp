@@ -16,6 +16,7 @@
         'libsass/src/backtrace.cpp',
         'libsass/src/base64vlq.cpp',
         'libsass/src/bind.cpp',
+        'libsass/src/call_cache.cpp',
         'libsass/src/cencode.c',
         'libsass/src/check_nesting.cpp',
         'libsass/src/color_maps.cpp',
@@ -39,10 +40,15 @@
         'libsass/src/operators.cpp',
         'libsass/src/operators.hpp',
         'libsass/src/output.cpp',
+        'libsass/src/parallel_extend.cpp',
+        'libsass/src/parallel_output.cpp',
+        'libsass/src/parallel_parse.cpp',
         'libsass/src/parser.cpp',
         'libsass/src/plugins.cpp',
         'libsass/src/position.cpp',
         'libsass/src/prelexer.cpp',
+        'libsass/src/profiler.cpp',
+        'libsass/src/purity.cpp',
         'libsass/src/remove_placeholders.cpp',
         'libsass/src/sass.cpp',
         'libsass/src/sass2scss.cpp',
@@ -0,0 +1,464 @@
+// Benchmark harness for LibSass
+//
+// Compiles a fixed set of generated workloads and reports the time
+// spent per phase, allocated nodes and peak memory as JSON. Each
+// workload runs in its own child process (except on Windows, where
+// the peak memory is not reported) to measure its own peak. Reports
+// of two commits can be compared by passing the older one as the
+// baseline, the exit status is then 1 if any workload regressed by
+// more than the threshold (in percent).
+//
+// make -C libsass bench BENCH_FLAGS="--output new.json"
+// make -C libsass bench BENCH_FLAGS="--baseline old.json --threshold 10"
+//
+// Options:
+//   --iterations N     compile each workload N times (median is reported)
+//   --scale F          scale the size of all workloads (i.e. 0.1 for a quick run)
+//   --only NAME        only run the named workload
+//   --output FILE      write the report to FILE instead of stdout
+//   --baseline FILE    compare with an earlier report
+//   --threshold PCT    allowed slow down against the baseline (default 10)
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iomanip>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#endif
+
+#include <sass.h>
+#include "../src/json.hpp"
+
+// one generated stylesheet
+struct Workload {
+  const char* name;
+  std::string (*generate)(double scale);
+  bool source_map;
+};
+
+// metrics of one compilation (times in milliseconds)
+struct Sample {
+  double total;
+  double parse;
+  double expand;
+  double check_nesting;
+  double cssize;
+  double extend;
+  double remove_placeholders;
+  double output;
+  double allocated_nodes;
+  double output_bytes;
+};
+
+static size_t scaled(size_t n, double scale)
+{
+  size_t s = (size_t)(n * scale);
+  return s ? s : 1;
+}
+
+// components, utilities and a grid like a css framework
+static std::string gen_framework(double scale)
+{
+  std::stringstream ss;
+  ss << "$grid-columns: 12;\n"
+        "$breakpoints: (xs: 0, sm: 576px, md: 768px, lg: 992px, xl: 1200px);\n"
+        "$theme-colors: (primary: #007bff, secondary: #6c757d, success: #28a745, info: #17a2b8,\n"
+        "  warning: #ffc107, danger: #dc3545, light: #f8f9fa, dark: #343a40);\n"
+        "$spacer: 1rem;\n"
+        "@function yiq($color) {\n"
+        "  $yiq: ((red($color) * 299) + (green($color) * 587) + (blue($color) * 114)) / 1000;\n"
+        "  @return if($yiq >= 150, #212529, #fff);\n"
+        "}\n"
+        "@mixin media-up($name) {\n"
+        "  $min: map-get($breakpoints, $name);\n"
+        "  @if $min != 0 { @media (min-width: $min) { @content; } } @else { @content; }\n"
+        "}\n"
+        "@mixin button-variant($bg) {\n"
+        "  color: yiq($bg); background-color: $bg; border-color: $bg;\n"
+        "  &:hover { background-color: darken($bg, 7.5%); border-color: darken($bg, 10%); }\n"
+        "  &:focus, &.focus { box-shadow: 0 0 0 .2rem rgba(mix(#fff, $bg, 15%), .5); }\n"
+        "  &.disabled, &:disabled { color: yiq($bg); opacity: .65; }\n"
+        "}\n";
+  for (size_t n = 0, N = scaled(25, scale); n < N; ++n) {
+    ss << ".theme-" << n << " {\n"
+          "  .btn { display: inline-block; padding: .375rem .75rem; border: 1px solid transparent;\n"
+          "    font-size: 1rem; line-height: 1.5; border-radius: .25rem; }\n"
+          "  @each $name, $color in $theme-colors {\n"
+          "    .btn-#{$name} { @extend .btn; @include button-variant($color); }\n"
+          "    .text-#{$name} { color: $color !important; }\n"
+          "    .bg-#{$name} { background-color: $color !important; }\n"
+          "    .alert-#{$name} { color: darken($color, 30%); background-color: lighten($color, 35%);\n"
+          "      hr { border-top-color: darken(lighten($color, 35%), 5%); } }\n"
+          "  }\n"
+          "  @each $bp, $width in $breakpoints {\n"
+          "    @include media-up($bp) {\n"
+          "      @for $i from 1 through $grid-columns {\n"
+          "        .col-#{$bp}-#{$i} { flex: 0 0 percentage($i / $grid-columns); max-width: percentage($i / $grid-columns); }\n"
+          "        .offset-#{$bp}-#{$i} { margin-left: percentage($i / $grid-columns); }\n"
+          "      }\n"
+          "    }\n"
+          "  }\n"
+          "  @each $prop, $abbr in (margin: m, padding: p) {\n"
+          "    @for $size from 0 through 5 {\n"
+          "      .#{$abbr}-#{$size} { #{$prop}: $spacer * $size * .25 !important; }\n"
+          "      .#{$abbr}x-#{$size} { #{$prop}-left: $spacer * $size * .25; #{$prop}-right: $spacer * $size * .25; }\n"
+          "    }\n"
+          "  }\n"
+          "}\n";
+  }
+  return ss.str();
+}
+
+// many selectors extending shared classes and placeholders
+static std::string gen_extend(double scale)
+{
+  std::stringstream ss;
+  size_t bases = 100;
+  for (size_t i = 0; i < bases; ++i) {
+    ss << "%placeholder-" << i << " { color: red; }\n";
+    ss << ".base-" << i << " { margin: " << i << "px; }\n";
+    ss << ".list-" << i % 10 << " .base-" << i << " > a { padding: " << i << "px; }\n";
+  }
+  for (size_t i = 0, N = scaled(2000, scale); i < N; ++i) {
+    ss << ".item-" << i << " { @extend %placeholder-" << i % bases << "; "
+       << "@extend .base-" << (i * 7) % bases << "; width: " << i << "px; }\n";
+  }
+  return ss.str();
+}
+
+// many @extends against many selectors, few of which match (this
+// is mostly the time to look up the extenders of each compound)
+static std::string gen_extend_lookup(double scale)
+{
+  std::stringstream ss;
+  size_t extenders = scaled(10000, scale);
+  for (size_t i = 0; i < extenders; ++i) {
+    ss << ".target-" << i << ".state-" << i % 7 << " { color: red; }\n";
+    ss << ".extender-" << i << " { @extend .target-" << i << ".state-" << i % 7 << "; }\n";
+  }
+  for (size_t i = 0, N = scaled(100000, scale); i < N; ++i) {
+    ss << ".block-" << i << ".state-" << i % 7 << " > .target-" << i % extenders << " { margin: 0; }\n";
+  }
+  return ss.str();
+}
+
+// nested selectors extending placeholders used in other nested
+// selectors (this is mostly the time to weave their parents)
+static std::string gen_extend_nested(double scale)
+{
+  std::stringstream ss;
+  size_t targets = 50;
+  for (size_t i = 0; i < targets; ++i) {
+    ss << ".page .section-" << i << " .row %link-" << i << ", "
+       << ".footer > .col-" << i << " %link-" << i << " { color: red; }\n";
+  }
+  for (size_t i = 0, N = scaled(1500, scale); i < N; ++i) {
+    ss << ".nav-" << i << " { .menu .item-" << i % 3 << " { > .link { @extend %link-" << i % targets << "; "
+       << "margin: " << i << "px; } } }\n";
+  }
+  return ss.str();
+}
+
+// design tokens built up with map-merge
+static std::string gen_tokens(double scale)
+{
+  std::stringstream ss;
+  ss << "@function deep-merge($a, $b) {\n"
+        "  @each $key, $value in $b {\n"
+        "    @if type-of($value) == map and type-of(map-get($a, $key)) == map {\n"
+        "      $value: deep-merge(map-get($a, $key), $value);\n"
+        "    }\n"
+        "    $a: map-merge($a, ($key: $value));\n"
+        "  }\n"
+        "  @return $a;\n"
+        "}\n"
+        "$tokens: ();\n";
+  ss << "@for $i from 1 through " << scaled(600, scale) << " {\n"
+        "  $tokens: deep-merge($tokens, (token-#{$i}: (size: $i * 1px, color: mix(red, blue, $i % 100 * 1%),\n"
+        "    space: (small: $i * .5px, large: $i * 2px))));\n"
+        "}\n"
+        "@each $name, $token in $tokens {\n"
+        "  .#{$name} { width: map-get($token, size); color: map-get($token, color);\n"
+        "    padding: map-get(map-get($token, space), small) map-get(map-get($token, space), large); }\n"
+        "}\n";
+  return ss.str();
+}
+
+// deeply recursive mixins and functions
+static std::string gen_recursion(double scale)
+{
+  std::stringstream ss;
+  ss << "@function sum($n) { @if $n <= 0 { @return 0; } @return $n + sum($n - 1); }\n"
+        "@mixin nest($depth) {\n"
+        "  width: sum($depth) * 1px;\n"
+        "  @if $depth > 0 { .d#{$depth} { @include nest($depth - 1); } }\n"
+        "}\n";
+  for (size_t i = 0, N = scaled(20, scale); i < N; ++i) {
+    ss << ".root-" << i << " { @include nest(40); }\n";
+  }
+  return ss.str();
+}
+
+// a large flat stylesheet without any sass features
+static std::string gen_flat(double scale)
+{
+  std::stringstream ss;
+  size_t target = scaled(10 * 1024 * 1024, scale);
+  for (size_t i = 0; (size_t)ss.tellp() < target; ++i) {
+    ss << ".rule-" << i << " > .child { color: #" << std::hex << std::setw(6) << std::setfill('0')
+       << (i * 2654435761u) % 0xffffff << std::dec << "; margin: " << i % 17 << "px " << i % 23 << "px; display: block; }\n";
+  }
+  return ss.str();
+}
+
+static const Workload workloads[] = {
+  { "framework", gen_framework, false },
+  { "framework-sourcemap", gen_framework, true },
+  { "extend", gen_extend, false },
+  { "extend-lookup", gen_extend_lookup, false },
+  { "extend-nested", gen_extend_nested, false },
+  { "tokens", gen_tokens, false },
+  { "recursion", gen_recursion, false },
+  { "flat", gen_flat, false },
+  { "flat-sourcemap", gen_flat, true },
+};
+
+static bool compile(const Workload& workload, const std::string& source, Sample& sample)
+{
+  struct Sass_Data_Context* data_ctx = sass_make_data_context(sass_copy_c_string(source.c_str()));
+  struct Sass_Context* ctx = sass_data_context_get_context(data_ctx);
+  struct Sass_Options* options = sass_context_get_options(ctx);
+  sass_option_set_output_path(options, "bench.css");
+  if (workload.source_map) {
+    sass_option_set_source_map_file(options, "bench.css.map");
+  }
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  int status = sass_compile_data_context(data_ctx);
+  std::chrono::duration<double, std::milli> total(std::chrono::steady_clock::now() - start);
+  if (status != 0) {
+    std::cerr << workload.name << ": " << sass_context_get_error_message(ctx);
+    sass_delete_data_context(data_ctx);
+    return false;
+  }
+  sample.total = total.count();
+  sample.parse = sass_context_get_parse_time(ctx);
+  sample.expand = sass_context_get_expand_time(ctx);
+  sample.check_nesting = sass_context_get_check_nesting_time(ctx);
+  sample.cssize = sass_context_get_cssize_time(ctx);
+  sample.extend = sass_context_get_extend_time(ctx);
+  sample.remove_placeholders = sass_context_get_remove_placeholders_time(ctx);
+  sample.output = sass_context_get_output_time(ctx);
+  sample.allocated_nodes = (double)sass_context_get_allocated_nodes(ctx);
+  sample.output_bytes = (double)sass_context_get_output_bytes(ctx);
+  sass_delete_data_context(data_ctx);
+  return true;
+}
+
+static double median(std::vector<Sample>& samples, double Sample::*field)
+{
+  std::vector<double> values;
+  for (const Sample& sample : samples) values.push_back(sample.*field);
+  std::sort(values.begin(), values.end());
+  return values[values.size() / 2];
+}
+
+static JsonNode* run(const Workload& workload, size_t iterations, double scale)
+{
+  std::string source(workload.generate(scale));
+  std::vector<Sample> samples;
+  for (size_t i = 0; i < iterations; ++i) {
+    Sample sample;
+    if (!compile(workload, source, sample)) return NULL;
+    samples.push_back(sample);
+  }
+  JsonNode* json = json_mkobject();
+  json_append_member(json, "input_bytes", json_mknumber((double)source.size()));
+  json_append_member(json, "output_bytes", json_mknumber(median(samples, &Sample::output_bytes)));
+  json_append_member(json, "total", json_mknumber(median(samples, &Sample::total)));
+  json_append_member(json, "parse", json_mknumber(median(samples, &Sample::parse)));
+  json_append_member(json, "expand", json_mknumber(median(samples, &Sample::expand)));
+  json_append_member(json, "check_nesting", json_mknumber(median(samples, &Sample::check_nesting)));
+  json_append_member(json, "cssize", json_mknumber(median(samples, &Sample::cssize)));
+  json_append_member(json, "extend", json_mknumber(median(samples, &Sample::extend)));
+  json_append_member(json, "remove_placeholders", json_mknumber(median(samples, &Sample::remove_placeholders)));
+  json_append_member(json, "output", json_mknumber(median(samples, &Sample::output)));
+  json_append_member(json, "allocated_nodes", json_mknumber(median(samples, &Sample::allocated_nodes)));
+  return json;
+}
+
+#ifndef _WIN32
+// runs the workload in a child process and adds the peak resident set
+// size of that child, since the high water mark of this process would
+// also hold the peaks of all workloads before it
+static JsonNode* run_forked(const Workload& workload, size_t iterations, double scale)
+{
+  int fds[2];
+  if (pipe(fds) != 0) return NULL;
+  std::cout.flush();
+  std::cerr.flush();
+  pid_t pid = fork();
+  if (pid < 0) {
+    close(fds[0]);
+    close(fds[1]);
+    return NULL;
+  }
+  if (pid == 0) {
+    close(fds[0]);
+    JsonNode* json = run(workload, iterations, scale);
+    if (!json) _exit(2);
+    char* str = json_encode(json);
+    for (size_t i = 0, n = strlen(str); i < n; ) {
+      ssize_t written = write(fds[1], str + i, n - i);
+      if (written <= 0) _exit(2);
+      i += written;
+    }
+    _exit(0);
+  }
+  close(fds[1]);
+  std::string contents;
+  char buffer[4096];
+  ssize_t size;
+  while ((size = read(fds[0], buffer, sizeof(buffer))) > 0) {
+    contents.append(buffer, size);
+  }
+  close(fds[0]);
+  int status = 0;
+  struct rusage usage;
+  if (wait4(pid, &status, 0, &usage) != pid) return NULL;
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) return NULL;
+  JsonNode* json = json_decode(contents.c_str());
+  if (!json) return NULL;
+  #ifdef __APPLE__
+    double peak_rss_kb = usage.ru_maxrss / 1024.0;
+  #else
+    double peak_rss_kb = (double)usage.ru_maxrss;
+  #endif
+  json_append_member(json, "peak_rss_kb", json_mknumber(peak_rss_kb));
+  return json;
+}
+#endif
+
+static bool read_file(const char* path, std::string& contents)
+{
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  if (!file) return false;
+  std::stringstream ss;
+  ss << file.rdbuf();
+  contents = ss.str();
+  return true;
+}
+
+// compare time and allocations with the baseline report
+static int compare(JsonNode* report, JsonNode* baseline, double threshold)
+{
+  int regressions = 0;
+  const char* metrics[] = { "total", "allocated_nodes" };
+  JsonNode* current = json_find_member(report, "workloads");
+  JsonNode* previous = json_find_member(baseline, "workloads");
+  if (!current || !previous) return 0;
+  JsonNode* workload;
+  json_foreach(workload, current) {
+    JsonNode* before = json_find_member(previous, workload->key);
+    if (!before) continue;
+    for (const char* metric : metrics) {
+      JsonNode* a = json_find_member(before, metric);
+      JsonNode* b = json_find_member(workload, metric);
+      if (!a || !b || a->tag != JSON_NUMBER || b->tag != JSON_NUMBER) continue;
+      if (a->number_ <= 0) continue;
+      double change = (b->number_ - a->number_) / a->number_ * 100;
+      if (change > threshold) {
+        std::cerr << "regression: " << workload->key << " " << metric << " "
+                  << a->number_ << " -> " << b->number_ << " (+" << change << "%)" << std::endl;
+        ++ regressions;
+      }
+    }
+  }
+  return regressions;
+}
+
+int main(int argc, char** argv)
+{
+  size_t iterations = 5;
+  double scale = 1;
+  double threshold = 10;
+  const char* only = NULL;
+  const char* output = NULL;
+  const char* baseline = NULL;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg(argv[i]);
+    if (i + 1 == argc) {
+      std::cerr << "missing value for " << arg << std::endl;
+      return 2;
+    }
+    if (arg == "--iterations") iterations = std::max(1, atoi(argv[++i]));
+    else if (arg == "--scale") scale = atof(argv[++i]);
+    else if (arg == "--threshold") threshold = atof(argv[++i]);
+    else if (arg == "--only") only = argv[++i];
+    else if (arg == "--output") output = argv[++i];
+    else if (arg == "--baseline") baseline = argv[++i];
+    else {
+      std::cerr << "unknown option " << arg << std::endl;
+      return 2;
+    }
+  }
+
+  JsonNode* report = json_mkobject();
+  JsonNode* results = json_mkobject();
+  json_append_member(report, "libsass", json_mkstring(libsass_version()));
+  json_append_member(report, "iterations", json_mknumber((double)iterations));
+  json_append_member(report, "scale", json_mknumber(scale));
+  for (const Workload& workload : workloads) {
+    if (only && strcmp(only, workload.name) != 0) continue;
+    #ifndef _WIN32
+      JsonNode* result = run_forked(workload, iterations, scale);
+    #else
+      JsonNode* result = run(workload, iterations, scale);
+    #endif
+    if (!result) {
+      json_delete(report);
+      json_delete(results);
+      return 2;
+    }
+    json_append_member(results, workload.name, result);
+  }
+  json_append_member(report, "workloads", results);
+
+  char* json = json_stringify(report, "  ");
+  if (output) {
+    std::ofstream file(output, std::ios::out | std::ios::binary);
+    file << json << std::endl;
+  }
+  else {
+    std::cout << json << std::endl;
+  }
+  free(json);
+
+  int status = 0;
+  if (baseline) {
+    std::string contents;
+    JsonNode* previous = NULL;
+    if (read_file(baseline, contents)) previous = json_decode(contents.c_str());
+    if (!previous) {
+      std::cerr << "could not read baseline " << baseline << std::endl;
+      status = 2;
+    }
+    else {
+      if (compare(report, previous, threshold)) status = 1;
+      json_delete(previous);
+    }
+  }
+
+  json_delete(report);
+  return status;
+}
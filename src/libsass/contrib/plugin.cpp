@@ -5,6 +5,7 @@
 
 // gcc: g++ -shared plugin.cpp -o plugin.so -fPIC -Llib -lsass
 // mingw: g++ -shared plugin.cpp -o plugin.dll -Llib -lsass
+// static (i.e. for node-sass): make plugin
 
 extern "C" const char* ADDCALL libsass_get_version() {
   return libsass_version();
@@ -21,15 +22,31 @@ union Sass_Value* custom_function(const union Sass_Value* s_args, Sass_Function_
   return sass_make_number((intptr_t)cookie, "px");
 }
 
+// converts pixels to rem, i.e. rem(24px) is 1.5rem
+union Sass_Value* rem_function(const union Sass_Value* s_args, Sass_Function_Entry cb, struct Sass_Compiler* comp)
+{
+  const union Sass_Value* px = sass_list_get_value(s_args, 0);
+  const union Sass_Value* base = sass_list_get_value(s_args, 1);
+  if (!sass_value_is_number(px) || !sass_value_is_number(base)) {
+    return sass_make_error("rem() expects numbers");
+  }
+  return sass_make_number(sass_number_get_value(px) / sass_number_get_value(base), "rem");
+}
+
 extern "C" Sass_Function_List ADDCALL libsass_load_functions()
 {
   // allocate a custom function caller
   Sass_Function_Entry c_func =
     sass_make_function("foo()", custom_function, (void*)42);
+  // the result only depends on the arguments, so it may be cached
+  Sass_Function_Entry c_rem =
+    sass_make_function("rem($px, $base: 16px)", rem_function, 0);
+  sass_function_set_pure(c_rem, true);
   // create list of all custom functions
-  Sass_Function_List fn_list = sass_make_function_list(1);
-  // put the only function in this plugin to the list
+  Sass_Function_List fn_list = sass_make_function_list(2);
+  // put the functions of this plugin to the list
   sass_function_set_list_entry(fn_list, 0, c_func);
+  sass_function_set_list_entry(fn_list, 1, c_rem);
   // return the list
   return fn_list;
 }
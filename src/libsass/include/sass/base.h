@@ -64,6 +64,15 @@ enum Sass_Output_Style {
   SASS_STYLE_TO_SASS
 };
 
+// Different profile reports
+enum Sass_Profile_Style {
+  SASS_PROFILE_NONE,
+  // plain text table
+  SASS_PROFILE_FLAT,
+  // chrome trace event json
+  SASS_PROFILE_TRACE
+};
+
 // to allocate buffer to be filled
 ADDAPI void* ADDCALL sass_alloc_memory(size_t size);
 // to allocate a buffer from existing string
@@ -71,6 +80,17 @@ ADDAPI char* ADDCALL sass_copy_c_string(const char* str);
 // to free overtaken memory when done
 ADDAPI void ADDCALL sass_free_memory(void* ptr);
 
+// Objects allocated by the compiler per node type
+// Only counted while tracking is enabled (off by default)
+ADDAPI void ADDCALL sass_heap_set_tracking(bool enabled);
+ADDAPI bool ADDCALL sass_heap_get_tracking(void);
+// Types are added in order of their first allocation
+ADDAPI size_t ADDCALL sass_heap_type_count(void);
+ADDAPI const char* ADDCALL sass_heap_type_name(size_t i);
+ADDAPI size_t ADDCALL sass_heap_type_size(size_t i);
+ADDAPI size_t ADDCALL sass_heap_type_live(size_t i);
+ADDAPI size_t ADDCALL sass_heap_type_total(size_t i);
+
 // Some convenient string helper function
 ADDAPI char* ADDCALL sass_string_quote (const char* str, const char quote_mark);
 ADDAPI char* ADDCALL sass_string_unquote (const char* str);
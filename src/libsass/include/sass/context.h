@@ -20,6 +20,7 @@ struct Sass_Options; // base struct
 struct Sass_Context; // : Sass_Options
 struct Sass_File_Context; // : Sass_Context
 struct Sass_Data_Context; // : Sass_Context
+struct Sass_Variant_Context; // : Sass_Context
 
 // Compiler states
 enum Sass_Compiler_State {
@@ -33,11 +34,31 @@ ADDAPI struct Sass_Options* ADDCALL sass_make_options (void);
 // Create and initialize a specific context
 ADDAPI struct Sass_File_Context* ADDCALL sass_make_file_context (const char* input_path);
 ADDAPI struct Sass_Data_Context* ADDCALL sass_make_data_context (char* source_string);
+ADDAPI struct Sass_Variant_Context* ADDCALL sass_make_variant_context (const char* prelude);
 
 // Call the compilation step for the specific context
 ADDAPI int ADDCALL sass_compile_file_context (struct Sass_File_Context* ctx);
 ADDAPI int ADDCALL sass_compile_data_context (struct Sass_Data_Context* ctx);
 
+// Only parse the specific context and resolve all of its imports
+// Nothing is evaluated, the context just reports included files and imports
+ADDAPI int ADDCALL sass_parse_file_context (struct Sass_File_Context* ctx);
+ADDAPI int ADDCALL sass_parse_data_context (struct Sass_Data_Context* ctx);
+
+// Parse the specific context once and compile it for every variant
+// The prelude of a variant is evaluated before the entry, the output
+// uses the options of the variant, results and errors are set on it
+// Prelude imports are resolved with the include paths, plugins and
+// custom callbacks of the entry (paths and plugins of the variant
+// are not used, its own custom callbacks are added to those)
+ADDAPI int ADDCALL sass_compile_file_variants (struct Sass_File_Context* ctx, struct Sass_Variant_Context** variants, size_t count);
+ADDAPI int ADDCALL sass_compile_data_variants (struct Sass_Data_Context* ctx, struct Sass_Variant_Context** variants, size_t count);
+
+// Stop a compilation running on another thread (safe to call from any thread)
+// It fails at the next checkpoint with error status 6, also for the variants
+// of the context that were not compiled yet. The context stays cancelled.
+ADDAPI void ADDCALL sass_context_cancel (struct Sass_Context* ctx);
+
 // Create a sass compiler instance for more control
 ADDAPI struct Sass_Compiler* ADDCALL sass_make_file_compiler (struct Sass_File_Context* file_ctx);
 ADDAPI struct Sass_Compiler* ADDCALL sass_make_data_compiler (struct Sass_Data_Context* data_ctx);
@@ -55,15 +76,18 @@ ADDAPI void ADDCALL sass_delete_options(struct Sass_Options* options);
 // Release all memory allocated and also ourself
 ADDAPI void ADDCALL sass_delete_file_context (struct Sass_File_Context* ctx);
 ADDAPI void ADDCALL sass_delete_data_context (struct Sass_Data_Context* ctx);
+ADDAPI void ADDCALL sass_delete_variant_context (struct Sass_Variant_Context* ctx);
 
 // Getters for context from specific implementation
 ADDAPI struct Sass_Context* ADDCALL sass_file_context_get_context (struct Sass_File_Context* file_ctx);
 ADDAPI struct Sass_Context* ADDCALL sass_data_context_get_context (struct Sass_Data_Context* data_ctx);
+ADDAPI struct Sass_Context* ADDCALL sass_variant_context_get_context (struct Sass_Variant_Context* variant_ctx);
 
 // Getters for Context_Options from Sass_Context
 ADDAPI struct Sass_Options* ADDCALL sass_context_get_options (struct Sass_Context* ctx);
 ADDAPI struct Sass_Options* ADDCALL sass_file_context_get_options (struct Sass_File_Context* file_ctx);
 ADDAPI struct Sass_Options* ADDCALL sass_data_context_get_options (struct Sass_Data_Context* data_ctx);
+ADDAPI struct Sass_Options* ADDCALL sass_variant_context_get_options (struct Sass_Variant_Context* variant_ctx);
 ADDAPI void ADDCALL sass_file_context_set_options (struct Sass_File_Context* file_ctx, struct Sass_Options* opt);
 ADDAPI void ADDCALL sass_data_context_set_options (struct Sass_Data_Context* data_ctx, struct Sass_Options* opt);
 
@@ -77,6 +101,15 @@ ADDAPI bool ADDCALL sass_option_get_source_map_contents (struct Sass_Options* op
 ADDAPI bool ADDCALL sass_option_get_source_map_file_urls (struct Sass_Options* options);
 ADDAPI bool ADDCALL sass_option_get_omit_source_map_url (struct Sass_Options* options);
 ADDAPI bool ADDCALL sass_option_get_is_indented_syntax_src (struct Sass_Options* options);
+ADDAPI bool ADDCALL sass_option_get_memoize_functions (struct Sass_Options* options);
+ADDAPI bool ADDCALL sass_option_get_memoize_mixins (struct Sass_Options* options);
+ADDAPI enum Sass_Profile_Style ADDCALL sass_option_get_profile_style (struct Sass_Options* options);
+ADDAPI int ADDCALL sass_option_get_parse_threads (struct Sass_Options* options);
+ADDAPI int ADDCALL sass_option_get_extend_threads (struct Sass_Options* options);
+ADDAPI int ADDCALL sass_option_get_output_threads (struct Sass_Options* options);
+ADDAPI size_t ADDCALL sass_option_get_time_limit (struct Sass_Options* options);
+ADDAPI size_t ADDCALL sass_option_get_node_limit (struct Sass_Options* options);
+ADDAPI size_t ADDCALL sass_option_get_output_limit (struct Sass_Options* options);
 ADDAPI const char* ADDCALL sass_option_get_indent (struct Sass_Options* options);
 ADDAPI const char* ADDCALL sass_option_get_linefeed (struct Sass_Options* options);
 ADDAPI const char* ADDCALL sass_option_get_input_path (struct Sass_Options* options);
@@ -96,6 +129,15 @@ ADDAPI void ADDCALL sass_option_set_source_map_contents (struct Sass_Options* op
 ADDAPI void ADDCALL sass_option_set_source_map_file_urls (struct Sass_Options* options, bool source_map_file_urls);
 ADDAPI void ADDCALL sass_option_set_omit_source_map_url (struct Sass_Options* options, bool omit_source_map_url);
 ADDAPI void ADDCALL sass_option_set_is_indented_syntax_src (struct Sass_Options* options, bool is_indented_syntax_src);
+ADDAPI void ADDCALL sass_option_set_memoize_functions (struct Sass_Options* options, bool memoize_functions);
+ADDAPI void ADDCALL sass_option_set_memoize_mixins (struct Sass_Options* options, bool memoize_mixins);
+ADDAPI void ADDCALL sass_option_set_profile_style (struct Sass_Options* options, enum Sass_Profile_Style profile_style);
+ADDAPI void ADDCALL sass_option_set_parse_threads (struct Sass_Options* options, int parse_threads);
+ADDAPI void ADDCALL sass_option_set_extend_threads (struct Sass_Options* options, int extend_threads);
+ADDAPI void ADDCALL sass_option_set_output_threads (struct Sass_Options* options, int output_threads);
+ADDAPI void ADDCALL sass_option_set_time_limit (struct Sass_Options* options, size_t time_limit);
+ADDAPI void ADDCALL sass_option_set_node_limit (struct Sass_Options* options, size_t node_limit);
+ADDAPI void ADDCALL sass_option_set_output_limit (struct Sass_Options* options, size_t output_limit);
 ADDAPI void ADDCALL sass_option_set_indent (struct Sass_Options* options, const char* indent);
 ADDAPI void ADDCALL sass_option_set_linefeed (struct Sass_Options* options, const char* linefeed);
 ADDAPI void ADDCALL sass_option_set_input_path (struct Sass_Options* options, const char* input_path);
@@ -120,7 +162,32 @@ ADDAPI const char* ADDCALL sass_context_get_error_src (struct Sass_Context* ctx)
 ADDAPI size_t ADDCALL sass_context_get_error_line (struct Sass_Context* ctx);
 ADDAPI size_t ADDCALL sass_context_get_error_column (struct Sass_Context* ctx);
 ADDAPI const char* ADDCALL sass_context_get_source_map_string (struct Sass_Context* ctx);
+ADDAPI const char* ADDCALL sass_context_get_profile_string (struct Sass_Context* ctx);
 ADDAPI char** ADDCALL sass_context_get_included_files (struct Sass_Context* ctx);
+ADDAPI size_t ADDCALL sass_context_get_call_cache_hits (struct Sass_Context* ctx);
+ADDAPI size_t ADDCALL sass_context_get_call_cache_misses (struct Sass_Context* ctx);
+ADDAPI size_t ADDCALL sass_context_get_pure_functions (struct Sass_Context* ctx);
+ADDAPI size_t ADDCALL sass_context_get_impure_functions (struct Sass_Context* ctx);
+ADDAPI size_t ADDCALL sass_context_get_mixin_cache_hits (struct Sass_Context* ctx);
+ADDAPI size_t ADDCALL sass_context_get_mixin_cache_misses (struct Sass_Context* ctx);
+ADDAPI double ADDCALL sass_context_get_parse_time (struct Sass_Context* ctx);
+ADDAPI double ADDCALL sass_context_get_expand_time (struct Sass_Context* ctx);
+ADDAPI double ADDCALL sass_context_get_check_nesting_time (struct Sass_Context* ctx);
+ADDAPI double ADDCALL sass_context_get_cssize_time (struct Sass_Context* ctx);
+ADDAPI double ADDCALL sass_context_get_extend_time (struct Sass_Context* ctx);
+ADDAPI double ADDCALL sass_context_get_remove_placeholders_time (struct Sass_Context* ctx);
+ADDAPI double ADDCALL sass_context_get_output_time (struct Sass_Context* ctx);
+ADDAPI char** ADDCALL sass_context_get_parsed_files (struct Sass_Context* ctx);
+ADDAPI double* ADDCALL sass_context_get_parse_times (struct Sass_Context* ctx);
+ADDAPI char** ADDCALL sass_context_get_import_parents (struct Sass_Context* ctx);
+ADDAPI char** ADDCALL sass_context_get_import_files (struct Sass_Context* ctx);
+ADDAPI size_t ADDCALL sass_context_get_function_calls (struct Sass_Context* ctx);
+ADDAPI size_t ADDCALL sass_context_get_mixin_includes (struct Sass_Context* ctx);
+ADDAPI size_t ADDCALL sass_context_get_extend_lookups (struct Sass_Context* ctx);
+ADDAPI size_t ADDCALL sass_context_get_allocated_nodes (struct Sass_Context* ctx);
+ADDAPI size_t ADDCALL sass_context_get_output_bytes (struct Sass_Context* ctx);
+ADDAPI size_t ADDCALL sass_context_get_c_function_calls (struct Sass_Context* ctx);
+ADDAPI size_t ADDCALL sass_context_get_c_function_cache_hits (struct Sass_Context* ctx);
 
 // Getters for options include path array
 ADDAPI size_t ADDCALL sass_option_get_include_path_size(struct Sass_Options* options);
@@ -136,6 +203,7 @@ ADDAPI char* ADDCALL sass_context_take_error_message (struct Sass_Context* ctx);
 ADDAPI char* ADDCALL sass_context_take_error_file (struct Sass_Context* ctx);
 ADDAPI char* ADDCALL sass_context_take_output_string (struct Sass_Context* ctx);
 ADDAPI char* ADDCALL sass_context_take_source_map_string (struct Sass_Context* ctx);
+ADDAPI char* ADDCALL sass_context_take_profile_string (struct Sass_Context* ctx);
 ADDAPI char** ADDCALL sass_context_take_included_files (struct Sass_Context* ctx);
 
 // Getters for Sass_Compiler options
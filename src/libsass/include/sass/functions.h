@@ -39,6 +39,10 @@ typedef struct Sass_Function* (*Sass_Function_List);
 // Typedef defining function signature and return type
 typedef union Sass_Value* (*Sass_Function_Fn)
   (const union Sass_Value*, Sass_Function_Entry cb, struct Sass_Compiler* compiler);
+// Same as above, but the argument list is handed over to the
+// callback, which must free it (or return it as the result)
+typedef union Sass_Value* (*Sass_Function_Take_Fn)
+  (union Sass_Value*, Sass_Function_Entry cb, struct Sass_Compiler* compiler);
 
 // Type of function calls
 enum Sass_Callee_Type {
@@ -119,6 +123,7 @@ ADDAPI void ADDCALL sass_delete_import (Sass_Import_Entry);
 // Creators for sass function list and function descriptors
 ADDAPI Sass_Function_List ADDCALL sass_make_function_list (size_t length);
 ADDAPI Sass_Function_Entry ADDCALL sass_make_function (const char* signature, Sass_Function_Fn cb, void* cookie);
+ADDAPI Sass_Function_Entry ADDCALL sass_make_function_take_args (const char* signature, Sass_Function_Take_Fn cb, void* cookie);
 ADDAPI void ADDCALL sass_delete_function (Sass_Function_Entry entry);
 ADDAPI void ADDCALL sass_delete_function_list (Sass_Function_List list);
 
@@ -129,8 +134,14 @@ ADDAPI void ADDCALL sass_function_set_list_entry(Sass_Function_List list, size_t
 // Getters for custom function descriptors
 ADDAPI const char* ADDCALL sass_function_get_signature (Sass_Function_Entry cb);
 ADDAPI Sass_Function_Fn ADDCALL sass_function_get_function (Sass_Function_Entry cb);
+ADDAPI Sass_Function_Take_Fn ADDCALL sass_function_get_take_function (Sass_Function_Entry cb);
 ADDAPI void* ADDCALL sass_function_get_cookie (Sass_Function_Entry cb);
 
+// Pure functions only depend on their arguments, so their
+// results are cached for the rest of the compilation
+ADDAPI bool ADDCALL sass_function_get_pure (Sass_Function_Entry cb);
+ADDAPI void ADDCALL sass_function_set_pure (Sass_Function_Entry cb, bool pure);
+
 
 #ifdef __cplusplus
 } // __cplusplus defined.
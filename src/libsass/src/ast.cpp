@@ -17,8 +17,6 @@
 
 namespace Sass {
 
-  static Null sass_null(ParserState("null"));
-
   bool Wrapped_Selector::find ( bool (*f)(AST_Node_Obj) )
   {
     // check children first
@@ -1849,7 +1847,10 @@ namespace Sass {
   void Number::reduce()
   {
     // apply conversion factor
-    value_ *= this->Units::reduce();
+    // (no write if there is nothing to reduce, the output
+    // inspects numbers that may be shared between threads)
+    double factor = this->Units::reduce();
+    if (factor != 1) value_ *= factor;
   }
 
   void Number::normalize()
@@ -2133,6 +2134,7 @@ namespace Sass {
   #define IMPLEMENT_AST_OPERATORS(klass) \
     klass##_Ptr klass::copy(std::string file, size_t line) const { \
       klass##_Ptr cpy = new klass(this); \
+      cpy->track(heap_type<klass>(#klass)); \
       cpy->trace(file, line); \
       return cpy; \
     } \
@@ -2146,7 +2148,9 @@ namespace Sass {
 
   #define IMPLEMENT_AST_OPERATORS(klass) \
     klass##_Ptr klass::copy() const { \
-      return new klass(this); \
+      klass##_Ptr cpy = new klass(this); \
+      cpy->track(heap_type<klass>(#klass)); \
+      return cpy; \
     } \
     klass##_Ptr klass::clone() const { \
       klass##_Ptr cpy = copy(); \
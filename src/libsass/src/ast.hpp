@@ -957,6 +957,7 @@ namespace Sass {
     ADD_PROPERTY(Sass_Function_Entry, c_function)
     ADD_PROPERTY(void*, cookie)
     ADD_PROPERTY(bool, is_overload_stub)
+    ADD_PROPERTY(bool, is_pure)
     ADD_PROPERTY(Signature, signature)
   public:
     Definition(const Definition* ptr)
@@ -969,6 +970,7 @@ namespace Sass {
       c_function_(ptr->c_function_),
       cookie_(ptr->cookie_),
       is_overload_stub_(ptr->is_overload_stub_),
+      is_pure_(ptr->is_pure_),
       signature_(ptr->signature_)
     { }
 
@@ -986,6 +988,7 @@ namespace Sass {
       c_function_(0),
       cookie_(0),
       is_overload_stub_(false),
+      is_pure_(false),
       signature_(0)
     { }
     Definition(ParserState pstate,
@@ -1003,6 +1006,7 @@ namespace Sass {
       c_function_(0),
       cookie_(0),
       is_overload_stub_(overload_stub),
+      is_pure_(false),
       signature_(sig)
     { }
     Definition(ParserState pstate,
@@ -1021,6 +1025,7 @@ namespace Sass {
       c_function_(c_func),
       cookie_(sass_function_get_cookie(c_func)),
       is_overload_stub_(false),
+      is_pure_(false),
       signature_(sig)
     { }
     ATTACH_AST_OPERATIONS(Definition)
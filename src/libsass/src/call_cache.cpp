@@ -0,0 +1,366 @@
+#include "sass.hpp"
+#include <typeinfo>
+
+#include "ast.hpp"
+#include "call_cache.hpp"
+
+namespace Sass {
+
+  // check if the value can take part in a cache key
+  static bool is_cacheable(Expression_Ptr val)
+  {
+    if (!val) return false;
+    if (Cast<Number>(val)) return true;
+    if (Cast<Color>(val)) return true;
+    if (Cast<Boolean>(val)) return true;
+    if (Cast<Null>(val)) return true;
+    if (Cast<String_Quoted>(val)) return true;
+    if (Cast<String_Constant>(val)) return true;
+    if (List_Ptr l = Cast<List>(val)) {
+      for (Expression_Obj item : l->elements()) {
+        if (!is_cacheable(item)) return false;
+      }
+      return true;
+    }
+    if (Map_Ptr m = Cast<Map>(val)) {
+      for (Expression_Obj key : m->keys()) {
+        if (!is_cacheable(key)) return false;
+        if (!is_cacheable(m->at(key))) return false;
+      }
+      return true;
+    }
+    return false;
+  }
+
+  // we can't use the node hashes, since they are cached on the
+  // instance and some types (i.e. numbers) are reduced in place
+  static size_t value_hash(Expression_Ptr val)
+  {
+    size_t hash = typeid(*val).hash_code();
+    if (Number_Ptr n = Cast<Number>(val)) {
+      hash_combine(hash, n->value());
+      for (const std::string& unit : n->numerators) hash_combine(hash, unit);
+      for (const std::string& unit : n->denominators) hash_combine(hash, unit);
+    }
+    else if (Color_Ptr c = Cast<Color>(val)) {
+      hash_combine(hash, c->r());
+      hash_combine(hash, c->g());
+      hash_combine(hash, c->b());
+      hash_combine(hash, c->a());
+      hash_combine(hash, c->disp());
+    }
+    else if (Boolean_Ptr b = Cast<Boolean>(val)) {
+      hash_combine(hash, b->value());
+    }
+    else if (String_Constant_Ptr s = dynamic_cast<String_Constant_Ptr>(val)) {
+      hash_combine(hash, s->value());
+      hash_combine(hash, s->quote_mark());
+    }
+    else if (List_Ptr l = Cast<List>(val)) {
+      hash_combine(hash, (int) l->separator());
+      hash_combine(hash, l->is_bracketed());
+      hash_combine(hash, l->is_arglist());
+      for (Expression_Obj item : l->elements()) {
+        hash_combine(hash, value_hash(item));
+      }
+    }
+    else if (Map_Ptr m = Cast<Map>(val)) {
+      for (Expression_Obj key : m->keys()) {
+        hash_combine(hash, value_hash(key));
+        hash_combine(hash, value_hash(m->at(key)));
+      }
+    }
+    return hash;
+  }
+
+  // strict equality, two values must render the same in every context
+  // the sass `==` operator is not good enough (i.e. `1px == 1`)
+  // we ignore `is_delayed`, it is reset once a variable is read
+  static bool value_equal(Expression_Ptr lhs, Expression_Ptr rhs)
+  {
+    if (typeid(*lhs) != typeid(*rhs)) return false;
+    if (Number_Ptr l = Cast<Number>(lhs)) {
+      Number_Ptr r = Cast<Number>(rhs);
+      return l->value() == r->value() &&
+             l->numerators == r->numerators &&
+             l->denominators == r->denominators;
+    }
+    if (Color_Ptr l = Cast<Color>(lhs)) {
+      Color_Ptr r = Cast<Color>(rhs);
+      return l->r() == r->r() && l->g() == r->g() &&
+             l->b() == r->b() && l->a() == r->a() &&
+             l->disp() == r->disp();
+    }
+    if (Boolean_Ptr l = Cast<Boolean>(lhs)) {
+      return l->value() == Cast<Boolean>(rhs)->value();
+    }
+    if (Cast<Null>(lhs)) {
+      return true;
+    }
+    if (String_Constant_Ptr l = dynamic_cast<String_Constant_Ptr>(lhs)) {
+      String_Constant_Ptr r = static_cast<String_Constant_Ptr>(rhs);
+      return l->value() == r->value() &&
+             l->quote_mark() == r->quote_mark() &&
+             l->can_compress_whitespace() == r->can_compress_whitespace();
+    }
+    if (List_Ptr l = Cast<List>(lhs)) {
+      List_Ptr r = Cast<List>(rhs);
+      if (l->length() != r->length()) return false;
+      if (l->separator() != r->separator()) return false;
+      if (l->is_bracketed() != r->is_bracketed()) return false;
+      if (l->is_arglist() != r->is_arglist()) return false;
+      for (size_t i = 0, L = l->length(); i < L; ++i) {
+        if (!value_equal(l->at(i), r->at(i))) return false;
+      }
+      return true;
+    }
+    if (Map_Ptr l = Cast<Map>(lhs)) {
+      Map_Ptr r = Cast<Map>(rhs);
+      if (l->length() != r->length()) return false;
+      for (size_t i = 0, L = l->length(); i < L; ++i) {
+        Expression_Obj lk = l->keys()[i], rk = r->keys()[i];
+        if (!value_equal(lk, rk)) return false;
+        if (!value_equal(l->at(lk), r->at(rk))) return false;
+      }
+      return true;
+    }
+    return false;
+  }
+
+  // cached values must not share any node with the
+  // evaluated tree, since those may be altered later
+  static Expression_Ptr value_copy(Expression_Ptr val)
+  {
+    if (List_Ptr l = Cast<List>(val)) {
+      List_Ptr cpy = SASS_MEMORY_COPY(l);
+      for (size_t i = 0, L = cpy->length(); i < L; ++i) {
+        cpy->at(i) = value_copy(cpy->at(i));
+      }
+      return cpy;
+    }
+    if (Map_Ptr m = Cast<Map>(val)) {
+      Map_Ptr cpy = SASS_MEMORY_NEW(Map, m->pstate(), m->length());
+      for (Expression_Obj key : m->keys()) {
+        *cpy << std::make_pair(value_copy(key), value_copy(m->at(key)));
+      }
+      cpy->is_delayed(m->is_delayed());
+      cpy->is_interpolant(m->is_interpolant());
+      return cpy;
+    }
+    return SASS_MEMORY_COPY(val);
+  }
+
+  // move a copied value and all of its items to pstate
+  static Expression_Ptr value_move(Expression_Ptr val, const ParserState& pstate)
+  {
+    val->pstate(pstate);
+    if (List_Ptr l = Cast<List>(val)) {
+      for (Expression_Obj item : l->elements()) value_move(item, pstate);
+    }
+    else if (Map_Ptr m = Cast<Map>(val)) {
+      for (Expression_Obj key : m->keys()) {
+        value_move(key, pstate);
+        value_move(m->at(key), pstate);
+      }
+    }
+    return val;
+  }
+
+  // check if an expanded mixin body can be cached
+  static bool is_cacheable(Block_Ptr b)
+  {
+    for (Statement_Obj stm : b->elements()) {
+      if (Declaration_Ptr d = Cast<Declaration>(stm)) {
+        if (d->value() && !is_cacheable(d->value())) return false;
+        if (d->block() && !is_cacheable(d->block())) return false;
+      }
+      else if (Trace_Ptr t = Cast<Trace>(stm)) {
+        if (!is_cacheable(t->block())) return false;
+      }
+      else if (Ruleset_Ptr r = Cast<Ruleset>(stm)) {
+        if (r->block() && !is_cacheable(r->block())) return false;
+      }
+      else if (!Cast<Comment>(stm)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // later stages alter the expanded tree in place, so
+  // we need a fresh copy of every block and declaration
+  static Block_Ptr block_copy(Block_Ptr b)
+  {
+    Block_Ptr cpy = SASS_MEMORY_NEW(Block, b->pstate(), b->length(), b->is_root());
+    for (Statement_Obj stm : b->elements()) {
+      if (Declaration_Ptr d = Cast<Declaration>(stm)) {
+        Declaration_Ptr decl = SASS_MEMORY_COPY(d);
+        decl->property(SASS_MEMORY_COPY(d->property()));
+        if (d->value()) decl->value(value_copy(d->value()));
+        if (d->block()) decl->block(block_copy(d->block()));
+        cpy->append(decl);
+      }
+      else if (Trace_Ptr t = Cast<Trace>(stm)) {
+        Trace_Ptr trace = SASS_MEMORY_COPY(t);
+        trace->block(block_copy(t->block()));
+        cpy->append(trace);
+      }
+      // @extend alters selectors in place
+      else if (Ruleset_Ptr r = Cast<Ruleset>(stm)) {
+        Ruleset_Ptr rule = SASS_MEMORY_COPY(r);
+        rule->selector(SASS_MEMORY_CLONE(r->selector()));
+        if (r->block()) rule->block(block_copy(r->block()));
+        cpy->append(rule);
+      }
+      else if (Comment_Ptr c = Cast<Comment>(stm)) {
+        cpy->append(SASS_MEMORY_COPY(c));
+      }
+    }
+    return cpy;
+  }
+
+  Call_Cache::Key::Key()
+  : def(0), args(), cacheable(false), selector(false), args_hash(0)
+  { }
+
+  Call_Cache::Key::Key(Definition_Ptr def, Arguments_Ptr args)
+  : def(def), args(), cacheable(true), selector(false), args_hash(0)
+  {
+    for (Argument_Obj arg : args->elements()) {
+      if (!is_cacheable(arg->value())) {
+        cacheable = false;
+        this->args.clear();
+        return;
+      }
+      Argument_Ptr cpy = SASS_MEMORY_COPY(arg);
+      cpy->value(value_copy(arg->value()));
+      hash_combine(args_hash, cpy->name());
+      hash_combine(args_hash, cpy->is_rest_argument());
+      hash_combine(args_hash, cpy->is_keyword_argument());
+      hash_combine(args_hash, value_hash(cpy->value()));
+      this->args.push_back(cpy);
+    }
+  }
+
+  void Call_Cache::Key::depend(Definition_Ptr callee)
+  {
+    callees.push_back(callee);
+  }
+
+  void Call_Cache::Key::depend(Expression_Ptr value)
+  {
+    values.push_back(value);
+    if (value && !is_cacheable(value)) cacheable = false;
+  }
+
+  void Call_Cache::Key::depend(const std::string& context)
+  {
+    contexts.push_back(context);
+  }
+
+  size_t Call_Cache::Key::hash() const
+  {
+    size_t hash = args_hash;
+    hash_combine(hash, def);
+    for (Definition_Ptr callee : callees) {
+      hash_combine(hash, callee);
+    }
+    for (Expression_Ptr value : values) {
+      hash_combine(hash, value ? value_hash(value) : 0);
+    }
+    for (const std::string& context : contexts) {
+      hash_combine(hash, context);
+    }
+    return hash;
+  }
+
+  Call_Cache::Call_Cache()
+  : entries_(), hits(0), misses(0)
+  { }
+
+  Call_Cache::Entry* Call_Cache::find(const Key& key)
+  {
+    auto range = entries_.equal_range(key.hash());
+    for (auto it = range.first; it != range.second; ++it) {
+      Entry& entry = it->second;
+      if (entry.def.ptr() != key.def) continue;
+      if (entry.args.size() != key.args.size()) continue;
+      if (entry.callees.size() != key.callees.size()) continue;
+      if (entry.values.size() != key.values.size()) continue;
+      if (entry.contexts != key.contexts) continue;
+      bool match = true;
+      for (size_t i = 0, L = entry.args.size(); match && i < L; ++i) {
+        Argument_Obj lhs = entry.args[i], rhs = key.args[i];
+        match = lhs->name() == rhs->name() &&
+                lhs->is_rest_argument() == rhs->is_rest_argument() &&
+                lhs->is_keyword_argument() == rhs->is_keyword_argument() &&
+                value_equal(lhs->value(), rhs->value());
+      }
+      for (size_t i = 0, L = entry.callees.size(); match && i < L; ++i) {
+        match = entry.callees[i].ptr() == key.callees[i];
+      }
+      for (size_t i = 0, L = entry.values.size(); match && i < L; ++i) {
+        Expression_Ptr lhs = entry.values[i], rhs = key.values[i];
+        match = lhs && rhs ? value_equal(lhs, rhs) : lhs == rhs;
+      }
+      if (match) {
+        ++ hits;
+        return &entry;
+      }
+    }
+    ++ misses;
+    return 0;
+  }
+
+  void Call_Cache::store(const Key& key, AST_Node_Ptr result)
+  {
+    Entry entry;
+    entry.def = key.def;
+    // the key already holds private copies
+    entry.args = key.args;
+    for (Definition_Ptr callee : key.callees) {
+      entry.callees.push_back(callee);
+    }
+    for (Expression_Obj value : key.values) {
+      entry.values.push_back(value ? value_copy(value) : 0);
+    }
+    entry.contexts = key.contexts;
+    entry.result = result;
+    entries_.insert(std::make_pair(key.hash(), entry));
+  }
+
+  Expression_Ptr Call_Cache::get(const Key& key)
+  {
+    if (!key.cacheable) return 0;
+    Entry* entry = find(key);
+    if (!entry) return 0;
+    return value_copy(Cast<Expression>(entry->result));
+  }
+
+  Expression_Ptr Call_Cache::get(const Key& key, const ParserState& pstate)
+  {
+    Expression_Ptr result = get(key);
+    return result ? value_move(result, pstate) : 0;
+  }
+
+  void Call_Cache::put(const Key& key, Expression_Ptr result)
+  {
+    if (!key.cacheable || !is_cacheable(result)) return;
+    store(key, value_copy(result));
+  }
+
+  Block_Ptr Call_Cache::get_block(const Key& key)
+  {
+    if (!key.cacheable) return 0;
+    Entry* entry = find(key);
+    if (!entry) return 0;
+    return block_copy(Cast<Block>(entry->result));
+  }
+
+  void Call_Cache::put_block(const Key& key, Block_Ptr block)
+  {
+    if (!key.cacheable || !is_cacheable(block)) return;
+    store(key, block_copy(block));
+  }
+
+}
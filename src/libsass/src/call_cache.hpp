@@ -0,0 +1,92 @@
+#ifndef SASS_CALL_CACHE_H
+#define SASS_CALL_CACHE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "ast_fwd_decl.hpp"
+#include "position.hpp"
+
+namespace Sass {
+
+  // Memoizes the results of function calls and the expanded bodies
+  // of mixin includes within one compilation. Only calls where every
+  // argument is a plain value (numbers, colors, strings, booleans,
+  // null and lists or maps thereof) can be cached. The caller decides
+  // if a definition is pure and adds any other state the result
+  // depends on to the key.
+  class Call_Cache {
+
+  public:
+
+    // Lookup key for one call. Created from the evaluated arguments
+    // before they are bound and reused for the later store. Binding
+    // alters the arguments in place, so the key keeps its own copy.
+    class Key {
+    public:
+      Key();
+      Key(Definition_Ptr def, Arguments_Ptr args);
+      // the result also depends on the resolved callee
+      void depend(Definition_Ptr callee);
+      // the result also depends on the variable value (or its absence)
+      void depend(Expression_Ptr value);
+      // the result also depends on the context (i.e. the parent selector)
+      void depend(const std::string& context);
+      size_t hash() const;
+      Definition_Ptr def;
+      std::vector<Argument_Obj> args;
+      std::vector<Definition_Ptr> callees;
+      std::vector<Expression_Obj> values;
+      std::vector<std::string> contexts;
+      bool cacheable;
+      // set by the purity analysis for mixins emitting nested rules
+      bool selector;
+    private:
+      size_t args_hash;
+    };
+
+  private:
+
+    struct Entry {
+      Definition_Obj def;
+      std::vector<Argument_Obj> args;
+      std::vector<Definition_Obj> callees;
+      std::vector<Expression_Obj> values;
+      std::vector<std::string> contexts;
+      AST_Node_Obj result;
+    };
+
+    std::unordered_multimap<size_t, Entry> entries_;
+
+    Entry* find(const Key& key);
+    void store(const Key& key, AST_Node_Ptr result);
+
+  public:
+
+    size_t hits;
+    size_t misses;
+
+    Call_Cache();
+
+    // returns a fresh copy of the cached result or NULL
+    Expression_Ptr get(const Key& key);
+    // same, but every node of the copy is moved to pstate
+    Expression_Ptr get(const Key& key, const ParserState& pstate);
+    // remember the result for the given key
+    void put(const Key& key, Expression_Ptr result);
+
+    // returns a fresh copy of the cached mixin body or NULL
+    Block_Ptr get_block(const Key& key);
+    // remember the expanded mixin body for the given key
+    void put_block(const Key& key, Block_Ptr block);
+
+    bool empty() { return entries_.empty(); }
+    size_t size() { return entries_.size(); }
+    void clear() { entries_.clear(); }
+
+  };
+
+}
+
+#endif
@@ -29,6 +29,8 @@
 #include "sass2scss.h"
 #include "prelexer.hpp"
 #include "emitter.hpp"
+#include "parallel_output.hpp"
+#include "parallel_extend.hpp"
 
 namespace Sass {
   using namespace Constants;
@@ -62,6 +64,7 @@ namespace Sass {
   Context::Context(struct Sass_Context& c_ctx)
   : CWD(File::get_cwd()),
     c_options(c_ctx),
+    cancelled(c_ctx.cancelled),
     entry_path(""),
     head_imports(0),
     plugins(),
@@ -72,10 +75,27 @@ namespace Sass {
     resources(),
     sheets(),
     subset_map(),
+    call_cache(),
+    mixin_cache(),
+    purity(),
     import_stack(),
     callee_stack(),
     traces(),
+    stats(),
+    allocated_base(0),
+    compile_thread(),
+    time_limit(c_options.time_limit),
+    node_limit(c_options.node_limit),
+    output_limit(c_options.output_limit),
+    deadline(Stats_Clock::now() + std::chrono::milliseconds(time_limit)),
+    profiler(c_options.profile_style != SASS_PROFILE_NONE ? new Profiler(c_options.profile_style) : 0),
     c_compiler(NULL),
+    included_files(),
+    import_graph(),
+    parse_only(false),
+    shared_parse(false),
+    parse_threads(c_options.parse_threads > 1 ? c_options.parse_threads : 0),
+    parallel_parse(0),
 
     c_headers               (std::vector<Sass_Importer_Entry>()),
     c_importers             (std::vector<Sass_Importer_Entry>()),
@@ -112,6 +132,8 @@ namespace Sass {
     sort (c_importers.begin(), c_importers.end(), sort_importers);
 
     emitter.set_filename(abs2rel(output_path, source_map_file, CWD));
+    emitter.cancelled = cancelled;
+    emitter.output_limit = output_limit;
 
   }
 
@@ -151,6 +173,10 @@ namespace Sass {
     // clear inner structures (vectors) and input source
     resources.clear(); import_stack.clear();
     subset_map.clear(), sheets.clear();
+    call_cache.clear();
+    mixin_cache.clear();
+    purity.clear();
+    delete profiler;
   }
 
   Data_Context::~Data_Context()
@@ -166,6 +192,33 @@ namespace Sass {
   {
   }
 
+  Variant_Context::Variant_Context(struct Sass_Variant_Context& ctx, Context& parsed)
+  : Context(ctx), parsed(parsed), prelude(ctx.prelude)
+  {
+    shared_parse = true;
+    // the limits are those of the whole compilation
+    time_limit = parsed.time_limit;
+    node_limit = parsed.node_limit;
+    output_limit = emitter.output_limit = parsed.output_limit;
+    deadline = parsed.deadline;
+    // prelude imports are resolved like those of the entry, with its
+    // paths and custom callbacks only (the plugins of the entry included)
+    include_paths = parsed.include_paths;
+    c_headers = parsed.c_headers;
+    c_importers = parsed.c_importers;
+    c_functions = parsed.c_functions;
+    // the prelude is parsed on this thread, its imports in order
+    parse_threads = 0;
+  }
+
+  Variant_Context::~Variant_Context()
+  {
+    // the shared resources are freed by the parsed context
+    for (size_t i = 0; i < parsed.resources.size() && i < resources.size(); ++i) {
+      resources[i] = Resource(0, 0);
+    }
+  }
+
   void Context::collect_include_paths(const char* paths_str)
   {
     if (paths_str) {
@@ -264,20 +317,44 @@ namespace Sass {
     //   return;
     // }
 
-    // get index for this resource
-    size_t idx = resources.size();
+    // parse the entry and all its imports on several threads first,
+    // they are then registered below in the order of a serial parse
+    // custom importers and headers are called in that order as well
+    if (import_stack.size() == 1 && !parallel_parse && parse_threads > 1 &&
+        c_importers.empty() && c_headers.empty()) {
+      Parallel_Parse parallel(*this, parse_threads);
+      if (parallel.run(inc, res)) {
+        parallel_parse = &parallel;
+        try { register_resource(inc, res); }
+        catch (...) { parallel_parse = 0; throw; }
+        parallel_parse = 0;
+        return;
+      }
+      // otherwise errors and warnings are reported by the serial parse
+    }
+
+    // the file was already parsed by a parallel parse
+    Parsed_Import* parsed = parallel_parse ? parallel_parse->take(inc.abs_path) : 0;
+
+    // get index for this resource (parallel parses
+    // reserve the index when the import is found)
+    size_t idx = parsed ? parsed->index : resources.size();
 
     // tell emitter about new resource
     emitter.add_source_index(idx);
 
     // put resources under our control
     // the memory will be freed later
-    resources.push_back(res);
+    if (idx >= resources.size()) {
+      resources.resize(idx + 1, Resource(0, 0));
+      srcmap_links.resize(idx + 1);
+    }
+    resources[idx] = res;
 
     // add a relative link to the working directory
     included_files.push_back(inc.abs_path);
     // add a relative link  to the source map output file
-    srcmap_links.push_back(abs2rel(inc.abs_path, source_map_file, CWD));
+    srcmap_links[idx] = abs2rel(inc.abs_path, source_map_file, CWD);
 
     // get pointer to the loaded content
     Sass_Import_Entry import = sass_make_import(
@@ -286,6 +363,8 @@ namespace Sass {
       res.contents,
       res.srcmap
     );
+    // the file currently being parsed imports this one
+    add_import_edge(inc.abs_path);
     // add the entry to the stack
     import_stack.push_back(import);
 
@@ -293,7 +372,7 @@ namespace Sass {
     const char* contents = resources[idx].contents;
     // keep a copy of the path around (for parserstates)
     // ToDo: we clean it, but still not very elegant!?
-    strings.push_back(sass_copy_c_string(inc.abs_path.c_str()));
+    strings.push_back(parsed ? parsed->path : sass_copy_c_string(inc.abs_path.c_str()));
     // create the initial parser state from resource
     ParserState pstate(strings.back(), contents, idx);
 
@@ -315,13 +394,45 @@ namespace Sass {
       }
     }
 
-    // create a parser instance from the given c_str buffer
-    Parser p(Parser::from_c_str(contents, *this, traces, pstate));
+    // imports are parsed recursively, so we
+    // subtract their time from our own time
+    size_t stat_idx = stats.files.size();
+    stats.files.push_back(std::make_pair(inc.abs_path, 0.0));
     // do not yet dispose these buffers
     sass_import_take_source(import);
     sass_import_take_srcmap(import);
-    // then parse the root block
-    Block_Obj root = p.parse();
+    Block_Obj root;
+    if (parsed) {
+      // load the imports in the order the parser found them
+      for (auto& child : parsed->imports) {
+        if (sheets.count(child.first.abs_path)) add_import_edge(child.first.abs_path);
+        else register_resource(child.first, parallel_parse->resource(child.first.abs_path), child.second);
+      }
+      // the nesting was checked by the parallel parse as well
+      root = parsed->root;
+      stats.files[stat_idx].second = parsed->parse_ms;
+      stats.allocated_nodes += parsed->allocated_nodes;
+    }
+    else {
+      double nested = stats.parse;
+      double nested_checks = stats.check_nesting;
+      Stats_Clock::time_point start = Stats_Clock::now();
+      // create a parser instance from the given c_str buffer
+      Parser p(Parser::from_c_str(contents, *this, traces, pstate));
+      // then parse the root block
+      root = p.parse();
+      double own = elapsed_ms(start) - (stats.parse - nested) - (stats.check_nesting - nested_checks);
+      stats.files[stat_idx].second = own;
+      stats.parse += own;
+      // check the nesting while the tree is still hot in the cache,
+      // files parsed again for custom importers are not used later
+      if ((!parse_only || shared_parse) && !sheets.count(inc.abs_path)) {
+        start = Stats_Clock::now();
+        CheckNesting check_nesting;
+        check_nesting(root);
+        stats.check_nesting += elapsed_ms(start);
+      }
+    }
     // delete memory of current stack frame
     sass_delete_import(import_stack.back());
     // remove current stack frame
@@ -350,6 +461,14 @@ namespace Sass {
     // this may return more than one valid result (ambiguous imp_path)
     const std::vector<Include> resolved(find_includes(imp));
 
+    // a parallel parse queues the file, it is registered once all
+    // files have been parsed (errors need the backtraces of that)
+    if (Parallel_Parse* parallel = Parallel_Parse::worker()) {
+      if (resolved.size() != 1) Parallel_Parse::serial_only();
+      parallel->import(resolved[0], pstate);
+      return resolved[0];
+    }
+
     // error nicely on ambiguous imp_path
     if (resolved.size() > 1) {
       std::stringstream msg_stream;
@@ -366,7 +485,10 @@ namespace Sass {
     else if (resolved.size() == 1) {
       bool use_cache = c_importers.size() == 0;
       // use cache for the resource loading
-      if (use_cache && sheets.count(resolved[0].abs_path)) return resolved[0];
+      if (use_cache && sheets.count(resolved[0].abs_path)) {
+        add_import_edge(resolved[0].abs_path);
+        return resolved[0];
+      }
       // try to read the content of the resolved file entry
       // the memory buffer returned must be freed by us!
       if (char* contents = read_file(resolved[0].abs_path)) {
@@ -382,6 +504,14 @@ namespace Sass {
 
   }
 
+  // record that the file on top of the import stack imports abs_path
+  // the bottom entry is only a placeholder for the entry file itself
+  void Context::add_import_edge(const std::string& abs_path)
+  {
+    if (import_stack.size() < 2) return;
+    import_graph.push_back(std::make_pair(std::string(import_stack.back()->abs_path), abs_path));
+  }
+
   void Context::import_url (Import_Ptr imp, std::string load_path, const std::string& ctx_path) {
 
     ParserState pstate(imp->pstate());
@@ -500,8 +630,10 @@ namespace Sass {
     return has_import;
   }
 
-  void register_function(Context&, Signature sig, Native_Function f, Env* env);
-  void register_function(Context&, Signature sig, Native_Function f, size_t arity, Env* env);
+  void register_function(Context&, Signature sig, Native_Function f, Env* env, bool pure = false);
+  void register_function(Context&, Signature sig, Native_Function f, size_t arity, Env* env, bool pure = false);
+  void register_pure_function(Context&, Signature sig, Native_Function f, Env* env);
+  void register_pure_function(Context&, Signature sig, Native_Function f, size_t arity, Env* env);
   void register_overload_stub(Context&, std::string name, Env* env);
   void register_built_in_functions(Context&, Env* env);
   void register_c_functions(Context&, Env* env, Sass_Function_List);
@@ -511,12 +643,23 @@ namespace Sass {
   {
     // check for valid block
     if (!root) return 0;
+    Stats_Clock::time_point start = Stats_Clock::now();
     // start the render process
-    root->perform(&emitter);
+    bool rendered = false;
+    if (c_options.output_threads > 1) {
+      Parallel_Output parallel(*this, c_options.output_threads);
+      rendered = parallel.run(root);
+    }
+    if (!rendered) root->perform(&emitter);
     // finish emitter stream
     emitter.finalize();
+    // the parts rendered on other threads are only checked on their own
+    if (output_limit && emitter.buffer().size() > output_limit) {
+      throw Exception::LimitExceeded("output", output_limit);
+    }
     // get the resulting buffer from stream
     OutputBuffer emitted = emitter.get_buffer();
+    stats.output += elapsed_ms(start);
     // should we append a source map url?
     if (!c_options.omit_source_map_url) {
       // generate an embeded source map
@@ -530,6 +673,7 @@ namespace Sass {
         emitted.buffer += format_source_mapping_url(source_map_file);
       }
     }
+    stats.output_bytes = emitted.buffer.size();
     // create a copy of the resulting buffer string
     // this must be freed or taken over by implementor
     return sass_copy_c_string(emitted.buffer.c_str());
@@ -593,6 +737,9 @@ namespace Sass {
     // create the source entry for file entry
     register_resource({{ input_path, "." }, abs_path }, { contents, 0 });
 
+    // only the imports were requested
+    if (parse_only) return sheets.at(entry_path).root;
+
     // create root ast tree node
     return compile();
 
@@ -635,13 +782,82 @@ namespace Sass {
     // register a synthetic resource (path does not really exist, skip in includes)
     register_resource({{ input_path, "." }, input_path }, { source_c_str, srcmap_c_str });
 
+    // only the imports were requested
+    if (parse_only) return sheets.at(entry_path).root;
+
     // create root ast tree node
     return compile();
   }
 
 
 
+  Block_Obj Variant_Context::parse()
+  {
+    // take over the sheets at the same resource indexes
+    entry_path = parsed.entry_path;
+    head_imports = parsed.head_imports;
+    resources = parsed.resources;
+    sheets = parsed.sheets;
+    included_files = parsed.included_files;
+    import_graph = parsed.import_graph;
+    stats.files = parsed.stats.files;
+    stats.parse = parsed.stats.parse;
+    stats.check_nesting = parsed.stats.check_nesting;
+    // the sources were registered in the order of the included files,
+    // linked relative to our own source map
+    SourceMap smap(parsed.emitter.smap());
+    srcmap_links.resize(resources.size());
+    for (size_t i = 0; i < smap.source_index.size(); ++i) {
+      emitter.add_source_index(smap.source_index[i]);
+      srcmap_links[smap.source_index[i]] = abs2rel(included_files[i], source_map_file, CWD);
+    }
+
+    Block_Obj entry = sheets.at(entry_path).root;
+    if (entry.isNull()) return 0;
+    Block_Obj root = SASS_MEMORY_NEW(Block, entry->pstate(), 0, true);
+
+    // create entry only for import stack
+    Sass_Import_Entry import = sass_make_import(
+      parsed.import_stack[0]->imp_path,
+      parsed.import_stack[0]->abs_path,
+      0, 0
+    );
+    import_stack.push_back(import);
+
+    if (prelude && *prelude) {
+      // registered like an import of the entry
+      std::string path("prelude");
+      register_resource({{ path, "." }, path }, { sass_copy_c_string(prelude), 0 });
+      // but not reported as an included file
+      included_files.erase(included_files.begin() + parsed.included_files.size());
+      root->concat(sheets.at(path).root);
+    }
+
+    // the prelude comes first, the entry is not changed
+    root->concat(entry);
+    sheets.at(entry_path).root = root;
+
+    // create root ast tree node
+    return compile();
+  }
+
   // parse root block from includes
+  void Context::checkpoint()
+  {
+    if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+      throw Exception::Cancelled();
+    }
+    if (time_limit && Stats_Clock::now() > deadline) {
+      throw Exception::LimitExceeded("time", time_limit);
+    }
+    // nodes of other threads are counted once they are joined
+    if (node_limit && std::this_thread::get_id() == compile_thread) {
+      if (stats.allocated_nodes + SharedObj::getAllocated() - allocated_base > node_limit) {
+        throw Exception::LimitExceeded("nodes", node_limit);
+      }
+    }
+  }
+
   Block_Obj Context::compile()
   {
     // abort if there is no data
@@ -661,30 +877,44 @@ namespace Sass {
     Expand expand(*this, &global);
     Cssize cssize(*this);
     CheckNesting check_nesting;
-    // check nesting in all files
-    for (auto sheet : sheets) {
-      auto styles = sheet.second;
-      check_nesting(styles.root);
-    }
+    // nesting of the parsed files was checked as they were parsed
     // expand and eval the tree
+    Stats_Clock::time_point start = Stats_Clock::now();
     root = expand(root);
+    stats.expand += elapsed_ms(start);
     // check nesting
+    start = Stats_Clock::now();
     check_nesting(root);
-    // merge and bubble certain rules
+    stats.check_nesting += elapsed_ms(start);
+    // merge and bubble certain rules, without
+    // extends placeholders can go in the same pass
+    start = Stats_Clock::now();
+    cssize.remove_placeholders = subset_map.empty();
     root = cssize(root);
+    stats.cssize += elapsed_ms(start);
+    checkpoint();
     // should we extend something?
     if (!subset_map.empty()) {
+      start = Stats_Clock::now();
       // create crtp visitor object
       Extend extend(subset_map);
       extend.setEval(expand.eval);
       // extend tree nodes
-      extend(root);
+      bool extended = false;
+      // chunks extended on other threads can not be held to the node limit
+      if (c_options.extend_threads > 1 && !node_limit) {
+        Parallel_Extend parallel(*this, extend, expand.eval, c_options.extend_threads);
+        extended = parallel.run(root);
+      }
+      if (!extended) extend(root);
+      stats.extend += elapsed_ms(start);
+
+      // clean up by removing empty placeholders
+      start = Stats_Clock::now();
+      Remove_Placeholders remove_placeholders;
+      root->perform(&remove_placeholders);
+      stats.remove_placeholders += elapsed_ms(start);
     }
-
-    // clean up by removing empty placeholders
-    // ToDo: maybe we can do this somewhere else?
-    Remove_Placeholders remove_placeholders;
-    root->perform(&remove_placeholders);
     // return processed tree
     return root;
   }
@@ -730,22 +960,36 @@ namespace Sass {
       return includes;
   }
 
-  void register_function(Context& ctx, Signature sig, Native_Function f, Env* env)
+  void register_function(Context& ctx, Signature sig, Native_Function f, Env* env, bool pure)
   {
     Definition_Ptr def = make_native_function(sig, f, ctx);
     def->environment(env);
+    def->is_pure(pure);
     (*env)[def->name() + "[f]"] = def;
   }
 
-  void register_function(Context& ctx, Signature sig, Native_Function f, size_t arity, Env* env)
+  void register_function(Context& ctx, Signature sig, Native_Function f, size_t arity, Env* env, bool pure)
   {
     Definition_Ptr def = make_native_function(sig, f, ctx);
     std::stringstream ss;
     ss << def->name() << "[f]" << arity;
     def->environment(env);
+    def->is_pure(pure);
     (*env)[ss.str()] = def;
   }
 
+  // pure functions only depend on their arguments
+  // their results may be memoized (see Call_Cache)
+  void register_pure_function(Context& ctx, Signature sig, Native_Function f, Env* env)
+  {
+    register_function(ctx, sig, f, env, true);
+  }
+
+  void register_pure_function(Context& ctx, Signature sig, Native_Function f, size_t arity, Env* env)
+  {
+    register_function(ctx, sig, f, arity, env, true);
+  }
+
   void register_overload_stub(Context& ctx, std::string name, Env* env)
   {
     Definition_Ptr stub = SASS_MEMORY_NEW(Definition,
@@ -755,6 +999,8 @@ namespace Sass {
                                        0,
                                        0,
                                        true);
+    // all overloads are registered as pure
+    stub->is_pure(true);
     (*env)[name + "[f]"] = stub;
   }
 
@@ -763,81 +1009,81 @@ namespace Sass {
   {
     using namespace Functions;
     // RGB Functions
-    register_function(ctx, rgb_sig, rgb, env);
+    register_pure_function(ctx, rgb_sig, rgb, env);
     register_overload_stub(ctx, "rgba", env);
-    register_function(ctx, rgba_4_sig, rgba_4, 4, env);
-    register_function(ctx, rgba_2_sig, rgba_2, 2, env);
-    register_function(ctx, red_sig, red, env);
-    register_function(ctx, green_sig, green, env);
-    register_function(ctx, blue_sig, blue, env);
-    register_function(ctx, mix_sig, mix, env);
+    register_pure_function(ctx, rgba_4_sig, rgba_4, 4, env);
+    register_pure_function(ctx, rgba_2_sig, rgba_2, 2, env);
+    register_pure_function(ctx, red_sig, red, env);
+    register_pure_function(ctx, green_sig, green, env);
+    register_pure_function(ctx, blue_sig, blue, env);
+    register_pure_function(ctx, mix_sig, mix, env);
     // HSL Functions
-    register_function(ctx, hsl_sig, hsl, env);
-    register_function(ctx, hsla_sig, hsla, env);
-    register_function(ctx, hue_sig, hue, env);
-    register_function(ctx, saturation_sig, saturation, env);
-    register_function(ctx, lightness_sig, lightness, env);
-    register_function(ctx, adjust_hue_sig, adjust_hue, env);
-    register_function(ctx, lighten_sig, lighten, env);
-    register_function(ctx, darken_sig, darken, env);
-    register_function(ctx, saturate_sig, saturate, env);
-    register_function(ctx, desaturate_sig, desaturate, env);
-    register_function(ctx, grayscale_sig, grayscale, env);
-    register_function(ctx, complement_sig, complement, env);
-    register_function(ctx, invert_sig, invert, env);
+    register_pure_function(ctx, hsl_sig, hsl, env);
+    register_pure_function(ctx, hsla_sig, hsla, env);
+    register_pure_function(ctx, hue_sig, hue, env);
+    register_pure_function(ctx, saturation_sig, saturation, env);
+    register_pure_function(ctx, lightness_sig, lightness, env);
+    register_pure_function(ctx, adjust_hue_sig, adjust_hue, env);
+    register_pure_function(ctx, lighten_sig, lighten, env);
+    register_pure_function(ctx, darken_sig, darken, env);
+    register_pure_function(ctx, saturate_sig, saturate, env);
+    register_pure_function(ctx, desaturate_sig, desaturate, env);
+    register_pure_function(ctx, grayscale_sig, grayscale, env);
+    register_pure_function(ctx, complement_sig, complement, env);
+    register_pure_function(ctx, invert_sig, invert, env);
     // Opacity Functions
-    register_function(ctx, alpha_sig, alpha, env);
-    register_function(ctx, opacity_sig, alpha, env);
-    register_function(ctx, opacify_sig, opacify, env);
-    register_function(ctx, fade_in_sig, opacify, env);
-    register_function(ctx, transparentize_sig, transparentize, env);
-    register_function(ctx, fade_out_sig, transparentize, env);
+    register_pure_function(ctx, alpha_sig, alpha, env);
+    register_pure_function(ctx, opacity_sig, alpha, env);
+    register_pure_function(ctx, opacify_sig, opacify, env);
+    register_pure_function(ctx, fade_in_sig, opacify, env);
+    register_pure_function(ctx, transparentize_sig, transparentize, env);
+    register_pure_function(ctx, fade_out_sig, transparentize, env);
     // Other Color Functions
-    register_function(ctx, adjust_color_sig, adjust_color, env);
-    register_function(ctx, scale_color_sig, scale_color, env);
-    register_function(ctx, change_color_sig, change_color, env);
-    register_function(ctx, ie_hex_str_sig, ie_hex_str, env);
+    register_pure_function(ctx, adjust_color_sig, adjust_color, env);
+    register_pure_function(ctx, scale_color_sig, scale_color, env);
+    register_pure_function(ctx, change_color_sig, change_color, env);
+    register_pure_function(ctx, ie_hex_str_sig, ie_hex_str, env);
     // String Functions
     register_function(ctx, unquote_sig, sass_unquote, env);
-    register_function(ctx, quote_sig, sass_quote, env);
-    register_function(ctx, str_length_sig, str_length, env);
-    register_function(ctx, str_insert_sig, str_insert, env);
-    register_function(ctx, str_index_sig, str_index, env);
-    register_function(ctx, str_slice_sig, str_slice, env);
-    register_function(ctx, to_upper_case_sig, to_upper_case, env);
-    register_function(ctx, to_lower_case_sig, to_lower_case, env);
+    register_pure_function(ctx, quote_sig, sass_quote, env);
+    register_pure_function(ctx, str_length_sig, str_length, env);
+    register_pure_function(ctx, str_insert_sig, str_insert, env);
+    register_pure_function(ctx, str_index_sig, str_index, env);
+    register_pure_function(ctx, str_slice_sig, str_slice, env);
+    register_pure_function(ctx, to_upper_case_sig, to_upper_case, env);
+    register_pure_function(ctx, to_lower_case_sig, to_lower_case, env);
     // Number Functions
-    register_function(ctx, percentage_sig, percentage, env);
-    register_function(ctx, round_sig, round, env);
-    register_function(ctx, ceil_sig, ceil, env);
-    register_function(ctx, floor_sig, floor, env);
-    register_function(ctx, abs_sig, abs, env);
-    register_function(ctx, min_sig, min, env);
-    register_function(ctx, max_sig, max, env);
+    register_pure_function(ctx, percentage_sig, percentage, env);
+    register_pure_function(ctx, round_sig, round, env);
+    register_pure_function(ctx, ceil_sig, ceil, env);
+    register_pure_function(ctx, floor_sig, floor, env);
+    register_pure_function(ctx, abs_sig, abs, env);
+    register_pure_function(ctx, min_sig, min, env);
+    register_pure_function(ctx, max_sig, max, env);
     register_function(ctx, random_sig, random, env);
     // List Functions
-    register_function(ctx, length_sig, length, env);
-    register_function(ctx, nth_sig, nth, env);
-    register_function(ctx, set_nth_sig, set_nth, env);
-    register_function(ctx, index_sig, index, env);
-    register_function(ctx, join_sig, join, env);
-    register_function(ctx, append_sig, append, env);
-    register_function(ctx, zip_sig, zip, env);
-    register_function(ctx, list_separator_sig, list_separator, env);
-    register_function(ctx, is_bracketed_sig, is_bracketed, env);
+    register_pure_function(ctx, length_sig, length, env);
+    register_pure_function(ctx, nth_sig, nth, env);
+    register_pure_function(ctx, set_nth_sig, set_nth, env);
+    register_pure_function(ctx, index_sig, index, env);
+    register_pure_function(ctx, join_sig, join, env);
+    register_pure_function(ctx, append_sig, append, env);
+    register_pure_function(ctx, zip_sig, zip, env);
+    register_pure_function(ctx, list_separator_sig, list_separator, env);
+    register_pure_function(ctx, is_bracketed_sig, is_bracketed, env);
     // Map Functions
-    register_function(ctx, map_get_sig, map_get, env);
-    register_function(ctx, map_merge_sig, map_merge, env);
-    register_function(ctx, map_remove_sig, map_remove, env);
-    register_function(ctx, map_keys_sig, map_keys, env);
-    register_function(ctx, map_values_sig, map_values, env);
-    register_function(ctx, map_has_key_sig, map_has_key, env);
+    register_pure_function(ctx, map_get_sig, map_get, env);
+    register_pure_function(ctx, map_merge_sig, map_merge, env);
+    register_pure_function(ctx, map_remove_sig, map_remove, env);
+    register_pure_function(ctx, map_keys_sig, map_keys, env);
+    register_pure_function(ctx, map_values_sig, map_values, env);
+    register_pure_function(ctx, map_has_key_sig, map_has_key, env);
     register_function(ctx, keywords_sig, keywords, env);
     // Introspection Functions
-    register_function(ctx, type_of_sig, type_of, env);
-    register_function(ctx, unit_sig, unit, env);
-    register_function(ctx, unitless_sig, unitless, env);
-    register_function(ctx, comparable_sig, comparable, env);
+    register_pure_function(ctx, type_of_sig, type_of, env);
+    register_pure_function(ctx, unit_sig, unit, env);
+    register_pure_function(ctx, unitless_sig, unitless, env);
+    register_pure_function(ctx, comparable_sig, comparable, env);
     register_function(ctx, variable_exists_sig, variable_exists, env);
     register_function(ctx, global_variable_exists_sig, global_variable_exists, env);
     register_function(ctx, function_exists_sig, function_exists, env);
@@ -847,10 +1093,10 @@ namespace Sass {
     register_function(ctx, content_exists_sig, content_exists, env);
     register_function(ctx, get_function_sig, get_function, env);
     // Boolean Functions
-    register_function(ctx, not_sig, sass_not, env);
+    register_pure_function(ctx, not_sig, sass_not, env);
     register_function(ctx, if_sig, sass_if, env);
     // Misc Functions
-    register_function(ctx, inspect_sig, inspect, env);
+    register_pure_function(ctx, inspect_sig, inspect, env);
     register_function(ctx, unique_id_sig, unique_id, env);
     // Selector functions
     register_function(ctx, selector_nest_sig, selector_nest, env);
@@ -874,6 +1120,8 @@ namespace Sass {
   {
     Definition_Ptr def = make_c_function(descr, ctx);
     def->environment(env);
+    // the catch-all function gets the called name as argument
+    def->is_pure(sass_function_get_pure(descr) && def->name() != "*");
     (*env)[def->name() + "[f]"] = def;
   }
 
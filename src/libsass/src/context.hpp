@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <thread>
 
 #define BUFFERSIZE 255
 #include "b64/encode.h"
@@ -15,6 +16,11 @@
 #include "environment.hpp"
 #include "source_map.hpp"
 #include "subset_map.hpp"
+#include "call_cache.hpp"
+#include "purity.hpp"
+#include "stats.hpp"
+#include "profiler.hpp"
+#include "parallel_parse.hpp"
 #include "backtrace.hpp"
 #include "output.hpp"
 #include "plugins.hpp"
@@ -39,6 +45,7 @@ namespace Sass {
   public:
     const std::string CWD;
     struct Sass_Options& c_options;
+    const std::atomic<bool>* cancelled;
     std::string entry_path;
     size_t head_imports;
     Plugins plugins;
@@ -53,14 +60,41 @@ namespace Sass {
     std::vector<Resource> resources;
     std::map<const std::string, StyleSheet> sheets;
     Subset_Map subset_map;
+    Call_Cache call_cache;
+    Call_Cache mixin_cache;
+    Purity purity;
     std::vector<Sass_Import_Entry> import_stack;
     std::vector<Sass_Callee> callee_stack;
     std::vector<Backtrace> traces;
 
+    // timings and counters
+    Compile_Stats stats;
+    // nodes allocated by this thread before the current phase
+    size_t allocated_base;
+    // the thread of the current phase, whose nodes are counted
+    std::thread::id compile_thread;
+    // the limits of the options, zero for none
+    size_t time_limit;
+    size_t node_limit;
+    size_t output_limit;
+    Stats_Clock::time_point deadline;
+    // only set if a profile was requested
+    Profiler* profiler;
+
     struct Sass_Compiler* c_compiler;
 
     // absolute paths to includes
     std::vector<std::string> included_files;
+    // direct imports as (importing file, imported file)
+    std::vector<std::pair<std::string, std::string>> import_graph;
+    // stop after the imports have been parsed
+    bool parse_only;
+    // the parsed sheets are shared with variant contexts
+    bool shared_parse;
+    // threads to parse the entry and its imports on, zero for none
+    size_t parse_threads;
+    // files parsed ahead on several threads (see parse_threads)
+    Parallel_Parse* parallel_parse;
     // relative includes for sourcemap
     std::vector<std::string> srcmap_links;
     // vectors above have same size
@@ -100,8 +134,12 @@ namespace Sass {
     void register_resource(const Include&, const Resource&, ParserState&);
     std::vector<Include> find_includes(const Importer& import);
     Include load_import(const Importer&, ParserState pstate);
+    void add_import_edge(const std::string& abs_path);
 
     Sass_Output_Style output_style() { return c_options.output_style; };
+    // throws once cancelled or over the time or node limit,
+    // checked between statements of every phase
+    void checkpoint();
     std::vector<std::string> get_included_files(bool skip = false, size_t headers = 0);
 
   private:
@@ -147,6 +185,18 @@ namespace Sass {
     virtual Block_Obj parse();
   };
 
+  // Compiles the sheets of another context, which only parsed them,
+  // with a prelude evaluated before the entry. The parsed context
+  // keeps the sheets and their resources, so it must outlive us.
+  class Variant_Context : public Context {
+  public:
+    Context& parsed;
+    const char* prelude;
+    Variant_Context(struct Sass_Variant_Context& ctx, Context& parsed);
+    virtual ~Variant_Context();
+    virtual Block_Obj parse();
+  };
+
 }
 
 #endif
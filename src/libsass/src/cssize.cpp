@@ -5,6 +5,7 @@
 
 #include "cssize.hpp"
 #include "context.hpp"
+#include "remove_placeholders.hpp"
 
 namespace Sass {
 
@@ -12,7 +13,8 @@ namespace Sass {
   : ctx(ctx),
     traces(ctx.traces),
     block_stack(std::vector<Block_Ptr>()),
-    p_stack(std::vector<Statement_Ptr>())
+    p_stack(std::vector<Statement_Ptr>()),
+    remove_placeholders(false)
   { }
 
   Statement_Ptr Cssize::parent()
@@ -142,6 +144,12 @@ namespace Sass {
 
   Statement_Ptr Cssize::operator()(Ruleset_Ptr r)
   {
+    ctx.checkpoint();
+    // before the children, so bubbled rules get the clean selector
+    if (remove_placeholders) {
+      Remove_Placeholders cleaner;
+      cleaner.remove_placeholders(r);
+    }
     p_stack.push_back(r);
     // this can return a string schema
     // string schema is not a statement!
@@ -23,6 +23,10 @@ namespace Sass {
     Cssize(Context&);
     ~Cssize() { }
 
+    // drop placeholder selectors while rules are visited; only
+    // valid if nothing is extended, otherwise Extend needs them
+    bool remove_placeholders;
+
     Selector_List_Ptr selector();
 
     Block_Ptr operator()(Block_Ptr);
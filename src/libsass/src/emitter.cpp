@@ -22,7 +22,8 @@ namespace Sass {
     in_media_block(false),
     in_declaration(false),
     in_space_array(false),
-    in_comma_array(false)
+    in_comma_array(false),
+    resumed(false)
   { }
 
   // return buffer as string
@@ -111,6 +112,65 @@ namespace Sass {
     wbuf.buffer = text + wbuf.buffer;
   }
 
+  bool Emitter::State::operator==(const State& rhs) const
+  {
+    return indentation == rhs.indentation
+        && scheduled_space == rhs.scheduled_space
+        && scheduled_linefeed == rhs.scheduled_linefeed
+        && scheduled_delimiter == rhs.scheduled_delimiter
+        && scheduled_crutch == rhs.scheduled_crutch
+        && in_custom_property == rhs.in_custom_property
+        && in_comment == rhs.in_comment
+        && in_wrapped == rhs.in_wrapped
+        && in_media_block == rhs.in_media_block
+        && in_declaration == rhs.in_declaration
+        && in_space_array == rhs.in_space_array
+        && in_comma_array == rhs.in_comma_array
+        && last_char == rhs.last_char;
+  }
+
+  Emitter::State Emitter::state(void) const
+  {
+    return {
+      indentation, scheduled_space, scheduled_linefeed,
+      scheduled_delimiter, scheduled_crutch,
+      in_custom_property, in_comment, in_wrapped, in_media_block,
+      in_declaration, in_space_array, in_comma_array,
+      wbuf.buffer.empty() ? '\0' : wbuf.buffer.back()
+    };
+  }
+
+  void Emitter::restore(const State& state)
+  {
+    indentation = state.indentation;
+    scheduled_space = state.scheduled_space;
+    scheduled_linefeed = state.scheduled_linefeed;
+    scheduled_delimiter = state.scheduled_delimiter;
+    scheduled_crutch = state.scheduled_crutch;
+    in_custom_property = state.in_custom_property;
+    in_comment = state.in_comment;
+    in_wrapped = state.in_wrapped;
+    in_media_block = state.in_media_block;
+    in_declaration = state.in_declaration;
+    in_space_array = state.in_space_array;
+    in_comma_array = state.in_comma_array;
+  }
+
+  void Emitter::resume(const State& state)
+  {
+    restore(state);
+    // not accounted for in the source map
+    resumed = state.last_char != '\0';
+    if (resumed) wbuf.buffer = state.last_char;
+  }
+
+  void Emitter::append_output(const Emitter& part)
+  {
+    wbuf.smap.append(part.wbuf);
+    wbuf.buffer.append(part.wbuf.buffer, part.resumed ? 1 : 0, std::string::npos);
+    restore(part.state());
+  }
+
   char Emitter::last_char()
   {
     return wbuf.buffer.back();
@@ -55,6 +55,39 @@ namespace Sass {
       bool in_space_array;
       bool in_comma_array;
 
+    public:
+      // everything the output of the next node depends on, so
+      // parts of a stylesheet can be rendered on their own
+      struct State {
+        size_t indentation;
+        size_t scheduled_space;
+        size_t scheduled_linefeed;
+        bool scheduled_delimiter;
+        AST_Node_Ptr scheduled_crutch;
+        bool in_custom_property;
+        bool in_comment;
+        bool in_wrapped;
+        bool in_media_block;
+        bool in_declaration;
+        bool in_space_array;
+        bool in_comma_array;
+        // the buffer is only asked for its last char (0 if empty)
+        char last_char;
+        bool operator==(const State& rhs) const;
+      };
+      State state(void) const;
+      // continue from a state on an empty emitter, the last
+      // char is buffered as a placeholder until appended
+      void resume(const State& state);
+      // append the output of an emitter that resumed from here
+      // and continue with the state it ended in
+      void append_output(const Emitter& part);
+
+    protected:
+      // whether the buffer starts with the resumed last char
+      bool resumed;
+      void restore(const State& state);
+
     public:
       // return buffer as std::string
       std::string get_buffer(void);
@@ -94,6 +94,20 @@ namespace Sass {
       msg  = "stack level too deep";
     }
 
+    LimitExceeded::LimitExceeded(const std::string& limit, size_t value)
+    : std::runtime_error(limit), limit(limit)
+    {
+      if (limit == "time") {
+        msg  = "Time limit of " + std::to_string(value) + "ms exceeded";
+      }
+      else if (limit == "nodes") {
+        msg  = "Node limit of " + std::to_string(value) + " exceeded";
+      }
+      else {
+        msg  = "Output limit of " + std::to_string(value) + " bytes exceeded";
+      }
+    }
+
     IncompatibleUnits::IncompatibleUnits(const Units& lhs, const Units& rhs)
     {
       msg  = "Incompatible units: '";
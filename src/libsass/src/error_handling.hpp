@@ -19,6 +19,7 @@ namespace Sass {
     const std::string def_op_msg = "Undefined operation";
     const std::string def_op_null_msg = "Invalid null operation";
     const std::string def_nesting_limit = "Code too deeply neested";
+    const std::string def_cancelled = "Compilation cancelled";
 
     class Base : public std::runtime_error {
       protected:
@@ -129,6 +130,29 @@ namespace Sass {
         virtual ~StackError() throw() {};
     };
 
+    /* thrown at the next checkpoint once the compilation was cancelled */
+    class Cancelled : public std::runtime_error {
+      public:
+        Cancelled()
+        : std::runtime_error(def_cancelled)
+        {};
+        virtual const char* errtype() const { return "Cancelled"; }
+        virtual ~Cancelled() throw() {};
+    };
+
+    /* thrown at the next checkpoint once over a limit of the options */
+    class LimitExceeded : public std::runtime_error {
+      protected:
+        std::string msg;
+      public:
+        // "time", "nodes" or "output"
+        const std::string limit;
+        LimitExceeded(const std::string& limit, size_t value);
+        virtual const char* errtype() const { return "LimitError"; }
+        virtual const char* what() const throw() { return msg.c_str(); }
+        virtual ~LimitExceeded() throw() {};
+    };
+
     /* common virtual base class (has no pstate or trace) */
     class OperationError : public std::runtime_error {
       protected:
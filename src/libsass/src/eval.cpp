@@ -29,6 +29,19 @@
 
 namespace Sass {
 
+  // calls a custom function and releases its argument list,
+  // unless the function took it over or returned it
+  static union Sass_Value* call_c_function(Sass_Function_Entry c_function, union Sass_Value* c_args, struct Sass_Compiler* compiler)
+  {
+    if (Sass_Function_Take_Fn c_func = sass_function_get_take_function(c_function)) {
+      return c_func(c_args, c_function, compiler);
+    }
+    Sass_Function_Fn c_func = sass_function_get_function(c_function);
+    union Sass_Value* c_val = c_func(c_args, c_function, compiler);
+    if (c_val != c_args) sass_delete_value(c_args);
+    return c_val;
+  }
+
   Eval::Eval(Expand& exp)
   : exp(exp),
     ctx(exp.ctx),
@@ -54,6 +67,7 @@ namespace Sass {
 
   Expression_Ptr Eval::operator()(Block_Ptr b)
   {
+    ctx.checkpoint();
     Expression_Ptr val = 0;
     for (size_t i = 0, L = b->length(); i < L; ++i) {
       val = b->at(i)->perform(this);
@@ -331,15 +345,13 @@ namespace Sass {
       // Block_Obj          body   = def->block();
       // Native_Function func   = def->native_function();
       Sass_Function_Entry c_function = def->c_function();
-      Sass_Function_Fn c_func = sass_function_get_function(c_function);
 
       To_C to_c;
       union Sass_Value* c_args = sass_make_list(1, SASS_COMMA, false);
       sass_list_set_value(c_args, 0, message->perform(&to_c));
-      union Sass_Value* c_val = c_func(c_args, c_function, ctx.c_compiler);
+      union Sass_Value* c_val = call_c_function(c_function, c_args, ctx.c_compiler);
       ctx.c_options.output_style = outstyle;
       ctx.callee_stack.pop_back();
-      sass_delete_value(c_args);
       sass_delete_value(c_val);
       return 0;
 
@@ -379,15 +391,13 @@ namespace Sass {
       // Block_Obj          body   = def->block();
       // Native_Function func   = def->native_function();
       Sass_Function_Entry c_function = def->c_function();
-      Sass_Function_Fn c_func = sass_function_get_function(c_function);
 
       To_C to_c;
       union Sass_Value* c_args = sass_make_list(1, SASS_COMMA, false);
       sass_list_set_value(c_args, 0, message->perform(&to_c));
-      union Sass_Value* c_val = c_func(c_args, c_function, ctx.c_compiler);
+      union Sass_Value* c_val = call_c_function(c_function, c_args, ctx.c_compiler);
       ctx.c_options.output_style = outstyle;
       ctx.callee_stack.pop_back();
-      sass_delete_value(c_args);
       sass_delete_value(c_val);
       return 0;
 
@@ -423,15 +433,13 @@ namespace Sass {
       // Block_Obj          body   = def->block();
       // Native_Function func   = def->native_function();
       Sass_Function_Entry c_function = def->c_function();
-      Sass_Function_Fn c_func = sass_function_get_function(c_function);
 
       To_C to_c;
       union Sass_Value* c_args = sass_make_list(1, SASS_COMMA, false);
       sass_list_set_value(c_args, 0, message->perform(&to_c));
-      union Sass_Value* c_val = c_func(c_args, c_function, ctx.c_compiler);
+      union Sass_Value* c_val = call_c_function(c_function, c_args, ctx.c_compiler);
       ctx.c_options.output_style = outstyle;
       ctx.callee_stack.pop_back();
-      sass_delete_value(c_args);
       sass_delete_value(c_val);
       return 0;
 
@@ -992,8 +1000,34 @@ namespace Sass {
     Parameters_Obj params = def->parameters();
     Env fn_env(def->environment());
     exp.env_stack.push_back(&fn_env);
+    ++ ctx.stats.function_calls;
+
+    // pure functions may be served from the cache, c functions
+    // declared pure are cached even if memoization is off
+    // source maps would point to the values of the first call
+    // (c functions create their result at the call site)
+    Call_Cache::Key memo;
+    Expression_Ptr cached = 0;
+    if ((ctx.c_options.memoize_functions && ctx.source_map_file.empty()) ||
+        (c_function && def->is_pure())) {
+      if (def->is_pure()) {
+        memo = Call_Cache::Key(def, args);
+      }
+      // user-defined functions are checked on each call
+      else if (body) {
+        memo = Call_Cache::Key(def, args);
+        if (!ctx.purity.dependencies(def, memo)) memo = Call_Cache::Key();
+      }
+      if (c_function) cached = ctx.call_cache.get(memo, c->pstate());
+      else cached = ctx.call_cache.get(memo);
+    }
 
-    if (func || body) {
+    if (cached) {
+      result = cached;
+      if (c_function) ++ ctx.stats.c_function_cache_hits;
+    }
+
+    else if (func || body) {
       bind(std::string("Function"), c->name(), params, args, &ctx, &fn_env, this);
       std::string msg(", in function `" + c->name() + "`");
       traces.push_back(Backtrace(c->pstate(), msg));
@@ -1005,6 +1039,7 @@ namespace Sass {
         SASS_CALLEE_FUNCTION,
         { env }
       });
+      if (ctx.profiler) ctx.profiler->enter(def, c->name(), SASS_CALLEE_FUNCTION);
 
       // eval the body if user-defined or special, invoke underlying CPP function if native
       if (body /* && !Prelexer::re_special_fun(name.c_str()) */) {
@@ -1016,6 +1051,8 @@ namespace Sass {
       if (!result) {
         error(std::string("Function ") + c->name() + " finished without @return", c->pstate(), traces);
       }
+      if (memo.cacheable) ctx.call_cache.put(memo, result);
+      if (ctx.profiler) ctx.profiler->exit();
       ctx.callee_stack.pop_back();
       traces.pop_back();
     }
@@ -1023,7 +1060,6 @@ namespace Sass {
     // else if it's a user-defined c function
     // convert call into C-API compatible form
     else if (c_function) {
-      Sass_Function_Fn c_func = sass_function_get_function(c_function);
       if (full_name == "*[f]") {
         String_Quoted_Obj str = SASS_MEMORY_NEW(String_Quoted, c->pstate(), c->name());
         Arguments_Obj new_args = SASS_MEMORY_NEW(Arguments, c->pstate());
@@ -1045,6 +1081,7 @@ namespace Sass {
         SASS_CALLEE_C_FUNCTION,
         { env }
       });
+      if (ctx.profiler) ctx.profiler->enter(def, c->name(), SASS_CALLEE_C_FUNCTION);
 
       To_C to_c;
       union Sass_Value* c_args = sass_make_list(params->length(), SASS_COMMA, false);
@@ -1055,19 +1092,20 @@ namespace Sass {
         Expression_Obj arg = Cast<Expression>(node);
         sass_list_set_value(c_args, i, arg->perform(&to_c));
       }
-      union Sass_Value* c_val = c_func(c_args, c_function, ctx.c_compiler);
+      union Sass_Value* c_val = call_c_function(c_function, c_args, ctx.c_compiler);
+      ++ ctx.stats.c_function_calls;
       if (sass_value_get_tag(c_val) == SASS_ERROR) {
         error("error in C function " + c->name() + ": " + sass_error_get_message(c_val), c->pstate(), traces);
       } else if (sass_value_get_tag(c_val) == SASS_WARNING) {
         error("warning in C function " + c->name() + ": " + sass_warning_get_message(c_val), c->pstate(), traces);
       }
       result = cval_to_astnode(c_val, traces, c->pstate());
+      if (memo.cacheable) ctx.call_cache.put(memo, result);
 
+      if (ctx.profiler) ctx.profiler->exit();
       ctx.callee_stack.pop_back();
       traces.pop_back();
-      sass_delete_value(c_args);
-      if (c_val != c_args)
-        sass_delete_value(c_val);
+      sass_delete_value(c_val);
     }
 
     // link back to function definition
@@ -85,7 +85,7 @@ namespace Sass {
       Block_Ptr bb = operator()(r->block());
       Keyframe_Rule_Obj k = SASS_MEMORY_NEW(Keyframe_Rule, r->pstate(), bb);
       if (r->selector()) {
-        if (Selector_List_Ptr s = r->selector()) {
+        if (Selector_List_Obj s = parsed_selector(r->selector())) {
           selector_stack.push_back(0);
           k->name(s->eval(eval));
           selector_stack.pop_back();
@@ -104,7 +104,7 @@ namespace Sass {
       has_parent_selector = ll != 0 && ll->length() > 0;
     }
 
-    Selector_List_Obj sel = r->selector();
+    Selector_List_Obj sel = parsed_selector(r->selector());
     if (sel) sel = sel->eval(eval);
 
     // check for parent selectors in base level rules
@@ -219,7 +219,7 @@ namespace Sass {
   {
     LOCAL_FLAG(in_keyframes, a->is_keyframes());
     Block_Ptr ab = a->block();
-    Selector_List_Ptr as = a->selector();
+    Selector_List_Obj as = parsed_selector(a->selector());
     Expression_Ptr av = a->value();
     selector_stack.push_back(0);
     if (av) av = av->perform(&eval);
@@ -638,12 +638,20 @@ namespace Sass {
 
   }
 
+  // eval changes selectors in place, those of sheets
+  // shared with other contexts are copied beforehand
+  Selector_List_Obj Expand::parsed_selector(Selector_List_Ptr s)
+  {
+    if (s && ctx.shared_parse) return SASS_MEMORY_CLONE(s);
+    return s;
+  }
+
   Statement* Expand::operator()(Extension_Ptr e)
   {
     if (Selector_List_Ptr extender = selector()) {
-      Selector_List_Ptr sl = e->selector();
+      Selector_List_Obj sl = parsed_selector(e->selector());
       // abort on invalid selector
-      if (sl == NULL) return NULL;
+      if (sl.isNull()) return NULL;
       if (Selector_Schema_Ptr schema = sl->schema()) {
         if (schema->has_real_parent_ref()) {
           // put root block on stack again (ignore parents)
@@ -694,6 +702,20 @@ namespace Sass {
     return 0;
   }
 
+  // link the selectors of nested rules to the enclosing media block
+  static void set_media_block(Block_Ptr b, Media_Block_Ptr mb)
+  {
+    for (Statement_Obj stm : b->elements()) {
+      if (Ruleset_Ptr r = Cast<Ruleset>(stm)) {
+        r->selector()->set_media_block(mb);
+        if (r->block()) set_media_block(r->block(), mb);
+      }
+      else if (Trace_Ptr t = Cast<Trace>(stm)) {
+        set_media_block(t->block(), mb);
+      }
+    }
+  }
+
   Statement_Ptr Expand::operator()(Mixin_Call_Ptr c)
   {
     if (recursions > maxRecursion) {
@@ -710,12 +732,40 @@ namespace Sass {
     Definition_Obj def = Cast<Definition>((*env)[full_name]);
     Block_Obj body = def->block();
     Parameters_Obj params = def->parameters();
+    if (c->name() != "@content") ++ ctx.stats.mixin_includes;
 
     if (c->block() && c->name() != "@content" && !body->has_content()) {
       error("Mixin \"" + c->name() + "\" does not accept a content block.", c->pstate(), traces);
     }
     Expression_Obj rv = c->arguments()->perform(&eval);
     Arguments_Obj args = Cast<Arguments>(rv);
+
+    // mixins without side effects may be served from the cache
+    // source maps would point to the arguments of the first call
+    Call_Cache::Key memo;
+    if (ctx.c_options.memoize_mixins && !c->block() &&
+        c->name() != "@content" && ctx.source_map_file.empty()) {
+      memo = Call_Cache::Key(def, args);
+      if (!ctx.purity.dependencies(def, memo)) memo = Call_Cache::Key();
+      // nested rules are resolved against the parent selector
+      else if (memo.selector) {
+        Selector_List_Obj parent = selector_stack.back();
+        if (!parent || parent->empty() || in_keyframes || block_stack.back()->is_root()) {
+          memo = Call_Cache::Key();
+        } else {
+          memo.depend(parent->to_string());
+        }
+      }
+      if (Block_Ptr cached = ctx.mixin_cache.get_block(memo)) {
+        if (Block_Ptr pr = block_stack.back()) {
+          cached->is_root(pr->is_root());
+        }
+        if (memo.selector) set_media_block(cached, media_block_stack.back());
+        recursions --;
+        return SASS_MEMORY_NEW(Trace, c->pstate(), c->name(), cached);
+      }
+    }
+
     std::string msg(", in mixin `" + c->name() + "`");
     traces.push_back(Backtrace(c->pstate(), msg));
     ctx.callee_stack.push_back({
@@ -726,6 +776,9 @@ namespace Sass {
       SASS_CALLEE_MIXIN,
       { env }
     });
+    // content blocks count towards the including mixin
+    bool profile = ctx.profiler && c->name() != "@content";
+    if (profile) ctx.profiler->enter(def, c->name(), SASS_CALLEE_MIXIN);
 
     Env new_env(def->environment());
     env_stack.push_back(&new_env);
@@ -760,7 +813,9 @@ namespace Sass {
     }
     block_stack.pop_back();
     env->del_global("is_in_mixin");
+    if (memo.cacheable) ctx.mixin_cache.put_block(memo, trace_block);
 
+    if (profile) ctx.profiler->exit();
     ctx.callee_stack.pop_back();
     env_stack.pop_back();
     traces.pop_back();
@@ -805,6 +860,7 @@ namespace Sass {
   // process and add to last block on stack
   inline void Expand::append_block(Block_Ptr b)
   {
+    ctx.checkpoint();
     if (b->is_root()) call_stack.push_back(b);
     for (size_t i = 0, L = b->length(); i < L; ++i) {
       Statement_Ptr stm = b->at(i);
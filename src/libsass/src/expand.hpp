@@ -42,6 +42,7 @@ namespace Sass {
 
   private:
     void expand_selector_list(Selector_Obj, Selector_List_Obj extender);
+    Selector_List_Obj parsed_selector(Selector_List_Ptr s);
 
   public:
     Expand(Context&, Env*, std::vector<Selector_List_Obj>* stack = NULL);
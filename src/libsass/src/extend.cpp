@@ -8,6 +8,7 @@
 #include "node.hpp"
 #include "sass_util.hpp"
 #include "remove_placeholders.hpp"
+#include "parallel_extend.hpp"
 #include "debug.hpp"
 #include <iostream>
 #include <deque>
@@ -356,13 +357,24 @@ namespace Sass {
   };
 
 
+  // The table of the lengths of the common subsequences, with the results of the
+  // comparator (parent superselector checks are costly, the backtrace reuses them).
+  // Both are flat arrays of x.size() rows and y.size() columns.
+  struct LcsSelectorTable {
+    size_t columns;
+    std::vector<int> lengths;
+    std::vector<Complex_Selector_Obj> matches;
+    int length(size_t i, size_t j) const { return lengths[i * columns + j]; }
+    const Complex_Selector_Obj& match(size_t i, size_t j) const { return matches[i * columns + j]; }
+  };
+
   /*
   This is the equivalent of ruby's Sass::Util.lcs_backtrace.
 
   # Computes a single longest common subsequence for arrays x and y.
   # Algorithm from http://en.wikipedia.org/wiki/Longest_common_subsequence_problem#Reading_out_an_LCS
   */
-  void lcs_backtrace(const LCSTable& c, ComplexSelectorDeque& x, ComplexSelectorDeque& y, int i, int j, const LcsCollectionComparator& comparator, ComplexSelectorDeque& out) {
+  void lcs_backtrace(const LcsSelectorTable& c, int i, int j, ComplexSelectorDeque& out) {
     //DEBUG_PRINTLN(LCS, "LCSBACK: X=" << x << " Y=" << y << " I=" << i << " J=" << j)
     // TODO: make printComplexSelectorDeque and use DEBUG_EXEC AND DEBUG_PRINTLN HERE to get equivalent output
 
@@ -372,22 +384,21 @@ namespace Sass {
     }
 
 
-    Complex_Selector_Obj pCompareOut;
-    if (comparator(x[i], y[j], pCompareOut)) {
+    if (const Complex_Selector_Obj& pCompareOut = c.match(i, j)) {
       DEBUG_PRINTLN(LCS, "RETURNING AFTER ELEM COMPARE")
-      lcs_backtrace(c, x, y, i - 1, j - 1, comparator, out);
+      lcs_backtrace(c, i - 1, j - 1, out);
       out.push_back(pCompareOut);
       return;
     }
 
-    if (c[i][j - 1] > c[i - 1][j]) {
+    if (c.length(i, j - 1) > c.length(i - 1, j)) {
       DEBUG_PRINTLN(LCS, "RETURNING AFTER TABLE COMPARE")
-      lcs_backtrace(c, x, y, i, j - 1, comparator, out);
+      lcs_backtrace(c, i, j - 1, out);
       return;
     }
 
     DEBUG_PRINTLN(LCS, "FINAL RETURN")
-    lcs_backtrace(c, x, y, i - 1, j, comparator, out);
+    lcs_backtrace(c, i - 1, j, out);
     return;
   }
 
@@ -397,11 +408,13 @@ namespace Sass {
   # Calculates the memoization table for the Least Common Subsequence algorithm.
   # Algorithm from http://en.wikipedia.org/wiki/Longest_common_subsequence_problem#Computing_the_length_of_the_LCS
   */
-  void lcs_table(const ComplexSelectorDeque& x, const ComplexSelectorDeque& y, const LcsCollectionComparator& comparator, LCSTable& out) {
+  void lcs_table(const ComplexSelectorDeque& x, const ComplexSelectorDeque& y, const LcsCollectionComparator& comparator, LcsSelectorTable& c) {
     //DEBUG_PRINTLN(LCS, "LCSTABLE: X=" << x << " Y=" << y)
     // TODO: make printComplexSelectorDeque and use DEBUG_EXEC AND DEBUG_PRINTLN HERE to get equivalent output
 
-    LCSTable c(x.size(), std::vector<int>(y.size()));
+    c.columns = y.size();
+    c.lengths.assign(x.size() * y.size(), 0);
+    c.matches.assign(x.size() * y.size(), Complex_Selector_Obj());
 
     // These shouldn't be necessary since the vector will be initialized to 0 already.
     // x.size.times {|i| c[i][0] = 0}
@@ -409,17 +422,16 @@ namespace Sass {
 
     for (size_t i = 1; i < x.size(); i++) {
       for (size_t j = 1; j < y.size(); j++) {
-        Complex_Selector_Obj pCompareOut;
+        Complex_Selector_Obj& pCompareOut = c.matches[i * c.columns + j];
 
         if (comparator(x[i], y[j], pCompareOut)) {
-          c[i][j] = c[i - 1][j - 1] + 1;
+          c.lengths[i * c.columns + j] = c.length(i - 1, j - 1) + 1;
         } else {
-          c[i][j] = std::max(c[i][j - 1], c[i - 1][j]);
+          pCompareOut = Complex_Selector_Obj();
+          c.lengths[i * c.columns + j] = std::max(c.length(i, j - 1), c.length(i - 1, j));
         }
       }
     }
-
-    out = c;
   }
 
   /*
@@ -440,13 +452,13 @@ namespace Sass {
     //DEBUG_PRINTLN(LCS, "LCS: X=" << x << " Y=" << y)
     // TODO: make printComplexSelectorDeque and use DEBUG_EXEC AND DEBUG_PRINTLN HERE to get equivalent output
 
-    x.push_front(NULL);
-    y.push_front(NULL);
+    x.insert(x.begin(), Complex_Selector_Obj());
+    y.insert(y.begin(), Complex_Selector_Obj());
 
-    LCSTable table;
+    LcsSelectorTable table;
     lcs_table(x, y, comparator, table);
 
-    return lcs_backtrace(table, x, y, static_cast<int>(x.size()) - 1, static_cast<int>(y.size()) - 1, comparator, out);
+    return lcs_backtrace(table, static_cast<int>(x.size()) - 1, static_cast<int>(y.size()) - 1, out);
   }
 
 
@@ -533,6 +545,19 @@ namespace Sass {
 
     DEBUG_PRINTLN(TRIM, "RESULT INITIAL: " << result)
 
+    // The selectors of the result (with their specificity) are compared with every
+    // other one, so they are only converted once. They are trimmed with the result.
+    typedef std::vector<std::pair<Complex_Selector_Obj, unsigned long> > TrimSelectors;
+    std::vector<TrimSelectors> resultSelectors(seqses.collection()->size());
+    for (size_t i = 0, L = resultSelectors.size(); i < L; ++i) {
+      NodeDeque& seqs = *(*seqses.collection())[i].collection();
+      resultSelectors[i].reserve(seqs.size());
+      for (Node& seq : seqs) {
+        Complex_Selector_Obj pSeq = nodeToComplexSelector(seq);
+        resultSelectors[i].push_back(std::make_pair(pSeq, pSeq->specificity()));
+      }
+    }
+
     // Normally we use the standard STL iterators, but in this case, we need to access the result collection by index since we're
     // iterating the input collection, computing a value, and then setting the result in the output collection. We have to keep track
     // of the index manually.
@@ -545,11 +570,13 @@ namespace Sass {
 
       Node tempResult = Node::createCollection();
       tempResult.got_line_feed = seqs1.got_line_feed;
+      TrimSelectors tempSelectors;
 
-      for (NodeDeque::iterator seqs1Iter = seqs1.collection()->begin(), seqs1EndIter = seqs1.collection()->end(); seqs1Iter != seqs1EndIter; ++seqs1Iter) {
-        Node& seq1 = *seqs1Iter;
+      for (size_t seq1Index = 0, seq1Count = seqs1.collection()->size(); seq1Index < seq1Count; ++seq1Index) {
+        Node& seq1 = (*seqs1.collection())[seq1Index];
 
-        Complex_Selector_Obj pSeq1 = nodeToComplexSelector(seq1);
+        // the selectors of seqs1 are not trimmed yet
+        const Complex_Selector_Obj& pSeq1 = resultSelectors[toTrimIndex][seq1Index].first;
 
         // Compute the maximum specificity. This requires looking at the "sources" of the sequence. See SimpleSequence.sources in the ruby code
         // for a good description of sources.
@@ -559,7 +586,7 @@ namespace Sass {
         // had an extra source that the ruby version did not have. Without a failing test case, this is going to be extra hard to find. My
         // best guess at this point is that we're cloning an object somewhere and maintaining the sources when we shouldn't be. This is purely
         // a guess though.
-        unsigned long maxSpecificity = isReplace ? pSeq1->specificity() : 0;
+        unsigned long maxSpecificity = isReplace ? resultSelectors[toTrimIndex][seq1Index].second : 0;
         ComplexSelectorSet sources = pSeq1->sources();
 
         DEBUG_PRINTLN(TRIM, "TRIM SEQ1: " << seq1)
@@ -574,10 +601,8 @@ namespace Sass {
 
         bool isMoreSpecificOuter = false;
 
-        int resultIndex = 0;
-
-        for (NodeDeque::iterator resultIter = result.collection()->begin(), resultIterEnd = result.collection()->end(); resultIter != resultIterEnd; ++resultIter) {
-          Node& seqs2 = *resultIter;
+        for (size_t resultIndex = 0, resultCount = result.collection()->size(); resultIndex < resultCount; ++resultIndex) {
+          Node& seqs2 = (*result.collection())[resultIndex];
 
           DEBUG_PRINTLN(TRIM, "SEQS1: " << seqs1)
           DEBUG_PRINTLN(TRIM, "SEQS2: " << seqs2)
@@ -593,16 +618,14 @@ namespace Sass {
 
           bool isMoreSpecificInner = false;
 
-          for (NodeDeque::iterator seqs2Iter = seqs2.collection()->begin(), seqs2IterEnd = seqs2.collection()->end(); seqs2Iter != seqs2IterEnd; ++seqs2Iter) {
-            Node& seq2 = *seqs2Iter;
+          for (const std::pair<Complex_Selector_Obj, unsigned long>& seq2 : resultSelectors[resultIndex]) {
+            const Complex_Selector_Obj& pSeq2 = seq2.first;
 
-            Complex_Selector_Obj pSeq2 = nodeToComplexSelector(seq2);
-
-            DEBUG_PRINTLN(TRIM, "SEQ2 SPEC: " << pSeq2->specificity())
-            DEBUG_PRINTLN(TRIM, "IS SPEC: " << pSeq2->specificity() << " >= " << maxSpecificity << " " << (pSeq2->specificity() >= maxSpecificity ? "true" : "false"))
+            DEBUG_PRINTLN(TRIM, "SEQ2 SPEC: " << seq2.second)
+            DEBUG_PRINTLN(TRIM, "IS SPEC: " << seq2.second << " >= " << maxSpecificity << " " << (seq2.second >= maxSpecificity ? "true" : "false"))
             DEBUG_PRINTLN(TRIM, "IS SUPER: " << (pSeq2->is_superselector_of(pSeq1) ? "true" : "false"))
 
-            isMoreSpecificInner = pSeq2->specificity() >= maxSpecificity && pSeq2->is_superselector_of(pSeq1);
+            isMoreSpecificInner = seq2.second >= maxSpecificity && pSeq2->is_superselector_of(pSeq1);
 
             if (isMoreSpecificInner) {
               DEBUG_PRINTLN(TRIM, "FOUND MORE SPECIFIC")
@@ -615,13 +638,12 @@ namespace Sass {
             isMoreSpecificOuter = true;
             break;
           }
-
-          resultIndex++;
         }
 
         if (!isMoreSpecificOuter) {
           DEBUG_PRINTLN(TRIM, "PUSHING: " << seq1)
           tempResult.collection()->push_back(seq1);
+          tempSelectors.push_back(resultSelectors[toTrimIndex][seq1Index]);
         }
 
       }
@@ -629,6 +651,7 @@ namespace Sass {
       DEBUG_PRINTLN(TRIM, "RESULT BEFORE ASSIGN: " << result)
       DEBUG_PRINTLN(TRIM, "TEMP RESULT: " << toTrimIndex << " " << tempResult)
       (*result.collection())[toTrimIndex] = tempResult;
+      resultSelectors[toTrimIndex].swap(tempSelectors);
 
       toTrimIndex++;
 
@@ -1519,15 +1542,13 @@ namespace Sass {
   };
   Node Extend::extendCompoundSelector(Compound_Selector_Ptr pSelector, CompoundSelectorSet& seen, bool isReplace) {
 
-    /* this turned out to be too much overhead
-       probably due to holding a "Node" object
     // check if we already extended this selector
     // we can do this since subset_map is "static"
-    auto memoized = memoizeCompound.find(pSelector);
+    Compound_Key key(compoundKey(pSelector, seen, isReplace));
+    auto memoized = memoizeCompound.find(key);
     if (memoized != memoizeCompound.end()) {
       return memoized->second.klone();
     }
-    */
 
     DEBUG_EXEC(EXTEND_COMPOUND, printCompoundSelector(pSelector, "EXTEND COMPOUND: "))
     // TODO: Ruby has another loop here to skip certain members?
@@ -1547,6 +1568,9 @@ namespace Sass {
     // for each (EXTENDER, TARGET) in MAP.get(COMPOUND):
     for (SubSetMapResult& groupedPair : arr) {
 
+      // one selector may be extended many times
+      checkpoint();
+
       Complex_Selector_Obj seq = groupedPair.first;
       SubSetMapPairs& group = groupedPair.second;
 
@@ -1641,6 +1665,8 @@ namespace Sass {
 
     for (SubSetMapLookup& pair : holder) {
 
+      checkpoint();
+
       Compound_Selector_Obj pSels = pair.first;
       Complex_Selector_Obj pNewSelector = pair.second;
 
@@ -1676,9 +1702,8 @@ namespace Sass {
 
     DEBUG_EXEC(EXTEND_COMPOUND, printCompoundSelector(pSelector, "EXTEND COMPOUND END: "))
 
-    // this turned out to be too much overhead
     // memory results in a map table - since extending is very expensive
-    // memoizeCompound.insert(std::pair<Compound_Selector_Obj, Node>(pSelector, results));
+    memoizeCompound.insert(std::make_pair(key, results.klone()));
 
     return results;
   }
@@ -1718,6 +1743,8 @@ namespace Sass {
           err << "You may only @extend selectors within the same directive.\n";
           err << "From \"@extend " << ext.second->to_string() << "\"";
           err << " on line " << pstate.line+1 << " of " << rel_path << "\n";
+          // reported with the backtraces of the main thread
+          if (chunk) chunk->stop();
           error(err.str(), selector->pstate(), eval->exp.traces);
         }
         if (entries.size() > 0) hasExtension = true;
@@ -1835,6 +1862,7 @@ namespace Sass {
 
     // for each list of complex selectors PATH in paths(CHOICES):
     for (Node& path : *paths.collection()) {
+      checkpoint();
       // add weave(PATH) to WEAVES
       Node weaved = weave(path); // slow(12%)!
       weaved.got_line_feed = path.got_line_feed;
@@ -1912,6 +1940,7 @@ namespace Sass {
 
       bool doReplace = isReplace;
       for (Node& childNode : *extendedSelectors.collection()) {
+        checkpoint();
         // When it is a replace, skip the first one, unless there is only one
         if(doReplace && extendedSelectors.collection()->size() > 1 ) {
           doReplace = false;
@@ -1968,6 +1997,8 @@ namespace Sass {
                     }
                   }
                   if (eval && extended) {
+                    // the evaluator is not shared with other threads
+                    if (chunk) chunk->serial_only();
                     eval->exp.selector_stack.push_back(pNewSelectors);
                     cpy_head->perform(eval);
                     eval->exp.selector_stack.pop_back();
@@ -2054,27 +2085,124 @@ namespace Sass {
 
     bool extendedSomething = false;
 
+    // a chunk extends its own clones, they are set in order later
+    Selector_List_Obj pSelectorList = pObject->selector();
+    if (chunk) pSelectorList = chunk->clone(pSelectorList);
+
     CompoundSelectorSet seen;
-    Selector_List_Obj pNewSelectorList = extendSelectorList(pObject->selector(), false, extendedSomething, seen);
+    Selector_List_Obj pNewSelectorList = extendSelectorList(pSelectorList, false, extendedSomething, seen);
 
     if (extendedSomething && pNewSelectorList) {
-      DEBUG_PRINTLN(EXTEND_OBJECT, "EXTEND ORIGINAL SELECTORS: " << pObject->selector()->to_string())
+      DEBUG_PRINTLN(EXTEND_OBJECT, "EXTEND ORIGINAL SELECTORS: " << pSelectorList->to_string())
       DEBUG_PRINTLN(EXTEND_OBJECT, "EXTEND SETTING NEW SELECTORS: " << pNewSelectorList->to_string())
       pNewSelectorList->remove_parent_selectors();
-      pObject->selector(pNewSelectorList);
+      if (chunk) chunk->selectors.push_back(std::make_pair(pObject, pNewSelectorList));
+      else pObject->selector(pNewSelectorList);
     } else {
       DEBUG_PRINTLN(EXTEND_OBJECT, "EXTEND DID NOT TRY TO EXTEND ANYTHING")
+      // the clone may still have been changed (like the original)
+      if (chunk) chunk->selectors.push_back(std::make_pair(pObject, pSelectorList));
     }
   }
 
-  Extend::Extend(Subset_Map& ssm)
-  : subset_map(ssm), eval(NULL)
+  Extend::Extend(Subset_Map& ssm, Extend_Chunk* chunk)
+  : subset_map(ssm), eval(NULL), chunk(chunk)
   { }
 
   void Extend::setEval(Eval& e) {
     eval = &e;
   }
 
+  void Extend::checkpoint()
+  {
+    if (eval) eval->ctx.checkpoint();
+    if (chunk) chunk->checkpoint();
+  }
+
+  size_t Extend::compoundId(const Compound_Selector_Obj& sel)
+  {
+    auto it = compoundIds.find(sel);
+    if (it != compoundIds.end()) return it->second;
+    compoundIds.insert(std::make_pair(sel, compounds.size()));
+    compounds.push_back(sel);
+    return compounds.size() - 1;
+  }
+
+  size_t Extend::sourceId(const Complex_Selector_Obj& sel)
+  {
+    auto it = sourceIds.find(sel);
+    if (it != sourceIds.end()) return it->second;
+    sourceIds.insert(std::make_pair(sel, sources.size()));
+    sources.push_back(sel);
+    return sources.size() - 1;
+  }
+
+  Extend::Compound_Key Extend::compoundKey(Compound_Selector_Ptr sel, const CompoundSelectorSet& seen, bool isReplace)
+  {
+    Compound_Key key;
+    key.reserve(seen.size() + sel->sources().size() + 2);
+    key.push_back(compoundId(sel) * 2 + isReplace);
+    key.push_back(seen.size());
+    for (auto const &it : seen) key.push_back(compoundId(it));
+    for (auto const &it : sel->sources()) key.push_back(sourceId(it));
+    return key;
+  }
+
+  bool Extend::compoundKey(const Extend& other, const Compound_Key& key, Compound_Key& ours, bool intern)
+  {
+    ours.assign(key.begin(), key.end());
+    for (size_t i = 0, seen_end = key[1] + 2; i < key.size(); ++i) {
+      if (i == 1) continue;
+      size_t id = i ? key[i] : key[i] / 2;
+      if (i < seen_end) {
+        const Compound_Selector_Obj& sel = other.compounds[id];
+        if (intern) id = compoundId(sel);
+        else {
+          auto it = compoundIds.find(sel);
+          if (it == compoundIds.end()) return false;
+          id = it->second;
+        }
+      }
+      else {
+        const Complex_Selector_Obj& sel = other.sources[id];
+        if (intern) id = sourceId(sel);
+        else {
+          auto it = sourceIds.find(sel);
+          if (it == sourceIds.end()) return false;
+          id = it->second;
+        }
+      }
+      ours[i] = i ? id : id * 2 + key[i] % 2;
+    }
+    return true;
+  }
+
+  bool Extend::memoizedAny(const Extend& other)
+  {
+    for (auto const &it : other.memoizeList) {
+      if (memoizeList.count(it.first)) return true;
+    }
+    for (auto const &it : other.memoizeComplex) {
+      if (memoizeComplex.count(it.first)) return true;
+    }
+    Compound_Key key;
+    for (auto const &it : other.memoizeCompound) {
+      if (compoundKey(other, it.first, key, false) && memoizeCompound.count(key)) return true;
+    }
+    return false;
+  }
+
+  void Extend::memoize(const Extend& other)
+  {
+    memoizeList.insert(other.memoizeList.begin(), other.memoizeList.end());
+    memoizeComplex.insert(other.memoizeComplex.begin(), other.memoizeComplex.end());
+    Compound_Key key;
+    for (auto const &it : other.memoizeCompound) {
+      compoundKey(other, it.first, key, true);
+      memoizeCompound.insert(std::make_pair(key, it.second));
+    }
+  }
+
   void Extend::operator()(Block_Ptr b)
   {
     for (size_t i = 0, L = b->length(); i < L; ++i) {
@@ -2082,30 +2210,33 @@ namespace Sass {
       stm->perform(this);
     }
     // do final check if everything was extended
+    if (b->is_root()) checkExtended();
+  }
+
+  void Extend::checkExtended()
+  {
     // we set `extended` flag on extended selectors
-    if (b->is_root()) {
-      // debug_subset_map(subset_map);
-      for(auto const &it : subset_map.values()) {
-        Complex_Selector_Ptr sel = NULL;
-        Compound_Selector_Ptr ext = NULL;
-        if (it.first) sel = it.first->first();
-        if (it.second) ext = it.second;
-        if (ext && (ext->extended() || ext->is_optional())) continue;
-        std::string str_sel(sel ? sel->to_string({ NESTED, 5 }) : "NULL");
-        std::string str_ext(ext ? ext->to_string({ NESTED, 5 }) : "NULL");
-        // debug_ast(sel, "sel: ");
-        // debug_ast(ext, "ext: ");
-        error("\"" + str_sel + "\" failed to @extend \"" + str_ext + "\".\n"
-              "The selector \"" + str_ext + "\" was not found.\n"
-              "Use \"@extend " + str_ext + " !optional\" if the"
-              " extend should be able to fail.", (ext ? ext->pstate() : NULL), eval->exp.traces);
-      }
+    // debug_subset_map(subset_map);
+    for(auto const &it : subset_map.values()) {
+      Complex_Selector_Ptr sel = NULL;
+      Compound_Selector_Ptr ext = NULL;
+      if (it.first) sel = it.first->first();
+      if (it.second) ext = it.second;
+      if (ext && (ext->extended() || ext->is_optional())) continue;
+      std::string str_sel(sel ? sel->to_string({ NESTED, 5 }) : "NULL");
+      std::string str_ext(ext ? ext->to_string({ NESTED, 5 }) : "NULL");
+      // debug_ast(sel, "sel: ");
+      // debug_ast(ext, "ext: ");
+      error("\"" + str_sel + "\" failed to @extend \"" + str_ext + "\".\n"
+            "The selector \"" + str_ext + "\" was not found.\n"
+            "Use \"@extend " + str_ext + " !optional\" if the"
+            " extend should be able to fail.", (ext ? ext->pstate() : NULL), eval->exp.traces);
     }
-
   }
 
   void Extend::operator()(Ruleset_Ptr pRuleset)
   {
+    checkpoint();
     extendObjectWithSelectorAndBlock( pRuleset );
     pRuleset->block()->perform(this);
   }
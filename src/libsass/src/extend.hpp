@@ -15,10 +15,15 @@ namespace Sass {
 
   Node subweave(Node& one, Node& two);
 
+  struct Extend_Chunk;
+
   class Extend : public Operation_CRTP<void, Extend> {
 
     Subset_Map& subset_map;
     Eval* eval;
+    // set when extending a chunk of the root block
+    // on another thread, see parallel_extend.hpp
+    Extend_Chunk* chunk;
 
     void fallback_impl(AST_Node_Ptr n) { }
 
@@ -38,15 +43,47 @@ namespace Sass {
       CompareNodes // compare
     > memoizeComplex;
 
-    /* this turned out to be too much overhead
-       re-evaluate once we store an ast selector
+    // equal selectors get the same id, which is their
+    // index in compounds or sources (see memoizeCompound)
     std::unordered_map<
       Compound_Selector_Obj, // key
-      Node, // value
+      size_t, // value
+      HashNodes, // hasher
+      CompareNodes // compare
+    > compoundIds;
+    std::vector<Compound_Selector_Obj> compounds;
+    std::unordered_map<
+      Complex_Selector_Obj, // key
+      size_t, // value
       HashNodes, // hasher
       CompareNodes // compare
+    > sourceIds;
+    std::vector<Complex_Selector_Obj> sources;
+
+    // id of the selector (times two, plus one if replacing), the
+    // number of seen selectors, their ids and the ids of the sources
+    // of the selector (both sets are ordered by value)
+    typedef std::vector<size_t> Compound_Key;
+    struct HashCompoundKey {
+      size_t operator() (const Compound_Key& key) const {
+        size_t hash = 0;
+        for (size_t id : key) hash_combine(hash, id);
+        return hash;
+      }
+    };
+
+    std::unordered_map<
+      Compound_Key, // key
+      Node, // value
+      HashCompoundKey // hasher
     > memoizeCompound;
-    */
+
+    size_t compoundId(const Compound_Selector_Obj& sel);
+    size_t sourceId(const Complex_Selector_Obj& sel);
+    Compound_Key compoundKey(Compound_Selector_Ptr sel, const CompoundSelectorSet& seen, bool isReplace);
+    // the key of the other extend in our ids, false if
+    // we did not give one of its selectors an id yet
+    bool compoundKey(const Extend& other, const Compound_Key& key, Compound_Key& ours, bool intern);
 
     void extendObjectWithSelectorAndBlock(Ruleset_Ptr pObject);
     Node extendComplexSelector(Complex_Selector_Ptr sel, CompoundSelectorSet& seen, bool isReplace, bool isOriginal);
@@ -54,9 +91,17 @@ namespace Sass {
     bool complexSelectorHasExtension(Complex_Selector_Ptr selector, CompoundSelectorSet& seen);
     Node trim(Node& seqses, bool isReplace);
     Node weave(Node& path);
+    // throws once cancelled, over the time limit or stopped
+    void checkpoint();
 
   public:
     void setEval(Eval& eval);
+    // errors for the @extends that matched nothing
+    void checkExtended();
+    // true if the other extend memoized a selector memoized here
+    bool memoizedAny(const Extend& other);
+    // takes over the memoized selectors of the other extend
+    void memoize(const Extend& other);
     Selector_List_Ptr extendSelectorList(Selector_List_Obj pSelectorList, bool isReplace, bool& extendedSomething, CompoundSelectorSet& seen);
     Selector_List_Ptr extendSelectorList(Selector_List_Obj pSelectorList, bool isReplace = false) {
       bool extendedSomething = false;
@@ -68,7 +113,7 @@ namespace Sass {
       bool extendedSomething = false;
       return extendSelectorList(pSelectorList, isReplace, extendedSomething, seen);
     }
-    Extend(Subset_Map&);
+    Extend(Subset_Map&, Extend_Chunk* chunk = NULL);
     ~Extend() { }
 
     void operator()(Block_Ptr);
@@ -294,10 +294,12 @@ namespace Sass {
     // random_device degrades sharply once the entropy pool
     // is exhausted. For practical use, random_device is
     // generally only used to seed a PRNG such as mt19937.
-    static std::mt19937 rand(static_cast<unsigned int>(GetSeed()));
+    // One generator per thread, since compilations may
+    // run in parallel and mt19937 is not thread-safe.
+    static thread_local std::mt19937 rand(static_cast<unsigned int>(GetSeed()));
 
     // features
-    static std::set<std::string> features {
+    static const std::set<std::string> features {
       "global-variable-shadowing",
       "extend-selector-pseudoclass",
       "at-error",
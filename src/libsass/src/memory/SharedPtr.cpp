@@ -1,6 +1,8 @@
 #include "../sass.hpp"
 #include <iostream>
 #include <typeinfo>
+#include <mutex>
+#include <algorithm>
 
 #include "SharedPtr.hpp"
 #include "../ast_fwd_decl.hpp"
@@ -29,21 +31,131 @@ namespace Sass {
   std::vector<SharedObj*> SharedObj::all;
   #endif
 
-  bool SharedObj::taint = false;
+  // registry of all types and per thread shards with heap counters
+  static std::mutex heap_types_mutex;
+  static std::vector<Heap_Type*>& heap_types()
+  {
+    static std::vector<Heap_Type*> types;
+    return types;
+  }
+  static std::vector<Heap_Shard*>& heap_shards()
+  {
+    static std::vector<Heap_Shard*> shards;
+    return shards;
+  }
+  // counts of threads that exited
+  static Heap_Shard& retired_shard()
+  {
+    static Heap_Shard* shard = new Heap_Shard;
+    return *shard;
+  }
+
+  Heap_Shard::Heap_Shard()
+  {
+    for (size_t i = 0; i < capacity; ++i) {
+      live[i].store(0, std::memory_order_relaxed);
+      total[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  Heap_Shard::Thread_Shard::Thread_Shard()
+  {
+    std::lock_guard<std::mutex> lock(heap_types_mutex);
+    heap_shards().push_back(this);
+  }
+
+  Heap_Shard::Thread_Shard::~Thread_Shard()
+  {
+    std::lock_guard<std::mutex> lock(heap_types_mutex);
+    std::vector<Heap_Shard*>& shards = heap_shards();
+    shards.erase(std::remove(shards.begin(), shards.end(), this), shards.end());
+    Heap_Shard& retired = retired_shard();
+    for (size_t i = 0; i < capacity; ++i) {
+      add(retired.live[i], live[i].load(std::memory_order_relaxed));
+      add(retired.total[i], total[i].load(std::memory_order_relaxed));
+    }
+  }
+
+  std::atomic<bool> Heap_Type::tracking(false);
+
+  Heap_Type::Heap_Type(const char* name, size_t size)
+  : name(name), size(size), id(0), overflow_live(0), overflow_total(0)
+  {
+    std::lock_guard<std::mutex> lock(heap_types_mutex);
+    id = heap_types().size();
+    heap_types().push_back(this);
+  }
+
+  size_t Heap_Type::live()
+  {
+    long sum = overflow_live.load(std::memory_order_relaxed);
+    if (id < Heap_Shard::capacity) {
+      std::lock_guard<std::mutex> lock(heap_types_mutex);
+      sum += retired_shard().live[id].load(std::memory_order_relaxed);
+      for (Heap_Shard* shard : heap_shards()) {
+        sum += shard->live[id].load(std::memory_order_relaxed);
+      }
+    }
+    return sum > 0 ? sum : 0;
+  }
+
+  size_t Heap_Type::total()
+  {
+    long sum = overflow_total.load(std::memory_order_relaxed);
+    if (id < Heap_Shard::capacity) {
+      std::lock_guard<std::mutex> lock(heap_types_mutex);
+      sum += retired_shard().total[id].load(std::memory_order_relaxed);
+      for (Heap_Shard* shard : heap_shards()) {
+        sum += shard->total[id].load(std::memory_order_relaxed);
+      }
+    }
+    return sum > 0 ? sum : 0;
+  }
+
+  size_t Heap_Type::count()
+  {
+    std::lock_guard<std::mutex> lock(heap_types_mutex);
+    return heap_types().size();
+  }
+
+  Heap_Type* Heap_Type::get(size_t i)
+  {
+    std::lock_guard<std::mutex> lock(heap_types_mutex);
+    return i < heap_types().size() ? heap_types()[i] : 0;
+  }
+
+  std::atomic<bool> SharedObj::taint(false);
+  thread_local size_t SharedObj::allocated = 0;
 
   SharedObj::SharedObj()
-  : detached(false)
+  : refcounter(0),
+    detached(false)
     #ifdef DEBUG_SHARED_PTR
     , dbg(false)
     #endif
   {
-    refcounter = 0;
+    ++ allocated;
     #ifdef DEBUG_SHARED_PTR
       if (taint) all.push_back(this);
     #endif
   };
 
+  SharedObj::SharedObj(const SharedObj& rhs)
+  : heap_tag(rhs.heap_tag),
+    refcounter(rhs.refcounter.load(std::memory_order_relaxed)),
+    detached(rhs.detached.load(std::memory_order_relaxed))
+    #ifdef DEBUG_SHARED_PTR
+    , dbg(rhs.dbg)
+    #endif
+  {
+    #ifdef DEBUG_SHARED_PTR
+      file = rhs.file;
+      line = rhs.line;
+    #endif
+  };
+
   SharedObj::~SharedObj() {
+    if (heap_tag.type) heap_tag.type->released();
     #ifdef DEBUG_SHARED_PTR
       if (dbg) std::cerr << "Destruct " << this << "\n";
       if(!all.empty()) { // check needed for MSVC (no clue why?)
@@ -54,16 +166,17 @@ namespace Sass {
 
   void SharedPtr::decRefCount() {
     if (node) {
-      -- node->refcounter;
+      // the release orders our writes before the delete on another thread
+      long count = node->refcounter.fetch_sub(1, std::memory_order_acq_rel) - 1;
       #ifdef DEBUG_SHARED_PTR
-        if (node->dbg)  std::cerr << "- " << node << " X " << node->refcounter << " (" << this << ") " << "\n";
+        if (node->dbg)  std::cerr << "- " << node << " X " << count << " (" << this << ") " << "\n";
       #endif
-      if (node->refcounter == 0) {
+      if (count == 0) {
         #ifdef DEBUG_SHARED_PTR
           // AST_Node_Ptr ast = dynamic_cast<AST_Node*>(node);
           if (node->dbg) std::cerr << "DELETE NODE " << node << "\n";
         #endif
-        if (!node->detached) {
+        if (!node->detached.load(std::memory_order_relaxed)) {
           delete(node);
         }
       }
@@ -72,11 +185,13 @@ namespace Sass {
 
   void SharedPtr::incRefCount() {
     if (node) {
-      ++ node->refcounter;
-      node->detached = false;
+      long count = node->refcounter.fetch_add(1, std::memory_order_relaxed) + 1;
+      if (node->detached.load(std::memory_order_relaxed)) {
+        node->detached.store(false, std::memory_order_relaxed);
+      }
       #ifdef DEBUG_SHARED_PTR
         if (node->dbg) {
-          std::cerr << "+ " << node << " X " << node->refcounter << " (" << this << ") " << "\n";
+          std::cerr << "+ " << node << " X " << count << " (" << this << ") " << "\n";
         }
       #endif
     }
@@ -4,11 +4,101 @@
 #include "sass/base.h"
 
 #include <vector>
+#include <atomic>
 
 namespace Sass {
 
   class SharedPtr;
 
+  ///////////////////////////////////////////////////////////////////////////////
+  // Counters of live and total objects per concrete type. Kept for objects
+  // allocated via the macros below while tracking is enabled (it is off by
+  // default, each allocation then only checks the flag). Objects on the
+  // stack are not counted.
+  // Every thread counts into a shard of its own, so parallel compilations
+  // don't contend on shared cache lines. The shards are only added up when
+  // the counters are read.
+  ///////////////////////////////////////////////////////////////////////////////
+
+  class Heap_Type;
+
+  class Heap_Shard {
+  public:
+    // types with a higher id are counted in their Heap_Type
+    static const size_t capacity = 256;
+    // only written by the owning thread, with a relaxed load and
+    // store (no locked instructions, no read-modify-write), and read
+    // by others; objects released on another thread than allocated
+    // are counted down in the shard of the releasing thread
+    std::atomic<long> live[capacity];
+    std::atomic<long> total[capacity];
+    Heap_Shard();
+    // the shard of the calling thread
+    static Heap_Shard& local();
+    static void add(std::atomic<long>& counter, long n) {
+      counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+  private:
+    // registered while the thread runs, its
+    // counts are kept when the thread exits
+    class Thread_Shard;
+  };
+
+  class Heap_Shard::Thread_Shard : public Heap_Shard {
+  public:
+    Thread_Shard();
+    ~Thread_Shard();
+  };
+
+  inline Heap_Shard& Heap_Shard::local() {
+    static thread_local Thread_Shard shard;
+    return shard;
+  }
+
+  class Heap_Type {
+  public:
+    const char* name;
+    // shallow size of one object
+    size_t size;
+    // slot in the shards
+    size_t id;
+    // used if there are more types than slots
+    std::atomic<long> overflow_live;
+    std::atomic<long> overflow_total;
+    Heap_Type(const char* name, size_t size);
+    // objects are only counted while set
+    static std::atomic<bool> tracking;
+    void allocated() {
+      if (id < Heap_Shard::capacity) {
+        Heap_Shard& shard = Heap_Shard::local();
+        Heap_Shard::add(shard.live[id], 1);
+        Heap_Shard::add(shard.total[id], 1);
+      } else {
+        ++ overflow_live;
+        ++ overflow_total;
+      }
+    }
+    void released() {
+      if (id < Heap_Shard::capacity) {
+        Heap_Shard::add(Heap_Shard::local().live[id], -1);
+      } else {
+        -- overflow_live;
+      }
+    }
+    // sums of all threads
+    size_t live();
+    size_t total();
+    // types that were allocated so far
+    static size_t count();
+    static Heap_Type* get(size_t i);
+  };
+
+  template < class T >
+  Heap_Type* heap_type(const char* name) {
+    static Heap_Type type(name, sizeof(T));
+    return &type;
+  }
+
   ///////////////////////////////////////////////////////////////////////////////
   // Use macros for the allocation task, since overloading operator `new`
   // has been proven to be flaky under certain compilers (see comment below).
@@ -17,7 +107,7 @@ namespace Sass {
   #ifdef DEBUG_SHARED_PTR
 
     #define SASS_MEMORY_NEW(Class, ...) \
-      ((Class*)(new Class(__VA_ARGS__))->trace(__FILE__, __LINE__)) \
+      ((Class*)(new Class(__VA_ARGS__))->track(Sass::heap_type<Class>(#Class))->trace(__FILE__, __LINE__)) \
 
     #define SASS_MEMORY_COPY(obj) \
       ((obj)->copy(__FILE__, __LINE__)) \
@@ -28,7 +118,7 @@ namespace Sass {
   #else
 
     #define SASS_MEMORY_NEW(Class, ...) \
-      new Class(__VA_ARGS__) \
+      ((Class*)(new Class(__VA_ARGS__))->track(Sass::heap_type<Class>(#Class))) \
 
     #define SASS_MEMORY_COPY(obj) \
       ((obj)->copy()) \
@@ -39,6 +129,15 @@ namespace Sass {
   #endif
 
   class SharedObj {
+  private:
+    // counters of the concrete type (only set on the heap)
+    // not passed on to copies, so the counts stay balanced
+    struct Heap_Tag {
+      Heap_Type* type;
+      Heap_Tag() : type(0) { }
+      Heap_Tag(const Heap_Tag&) : type(0) { }
+      Heap_Tag& operator=(const Heap_Tag&) { return *this; }
+    } heap_tag;
   protected:
   friend class SharedPtr;
   friend class Memory_Manager;
@@ -47,10 +146,17 @@ namespace Sass {
       std::string file;
       size_t line;
     #endif
-    static bool taint;
-    long refcounter;
+    static std::atomic<bool> taint;
+    // counted per thread, so parallel
+    // compilations don't mix up
+    static thread_local size_t allocated;
+    // nodes may be shared with other threads (parallel phases,
+    // static values), so it is always updated atomically
+    std::atomic<long> refcounter;
     // long refcount;
-    bool detached;
+    // may still be set on parsed nodes that are shared
+    // between threads, so it is accessed atomically
+    std::atomic<bool> detached;
     #ifdef DEBUG_SHARED_PTR
       bool dbg;
     #endif
@@ -64,6 +170,14 @@ namespace Sass {
       }
     #endif
     SharedObj();
+    SharedObj(const SharedObj& rhs);
+    SharedObj* track(Heap_Type* type) {
+      if (Heap_Type::tracking.load(std::memory_order_relaxed)) {
+        heap_tag.type = type;
+        type->allocated();
+      }
+      return this;
+    }
     #ifdef DEBUG_SHARED_PTR
       std::string getDbgFile() {
         return file;
@@ -78,9 +192,13 @@ namespace Sass {
     static void setTaint(bool val) {
       taint = val;
     }
+    // number of nodes created so far on this thread
+    static size_t getAllocated() {
+      return allocated;
+    }
     virtual ~SharedObj();
     long getRefCount() {
-      return refcounter;
+      return refcounter.load(std::memory_order_relaxed);
     }
   };
 
@@ -122,7 +240,7 @@ namespace Sass {
     };
     SharedObj* detach() const {
       if (node) {
-        node->detached = true;
+        node->detached.store(true, std::memory_order_relaxed);
       }
       return node;
     };
@@ -7,6 +7,64 @@
 
 namespace Sass {
 
+  // released collections of this thread, for reuse
+  struct NodeDequePool {
+    std::vector<NodeDeque*> free;
+    ~NodeDequePool() { for (NodeDeque* pDeque : free) delete pDeque; }
+  };
+  static thread_local NodeDequePool pool;
+  // bounds the memory kept by the pool
+  static const size_t pool_size = 1024;
+  static const size_t pool_capacity = 16;
+
+  NodeDequePtr::NodeDequePtr(NodeDeque* pDeque)
+  : mpDeque(pDeque)
+  { retain(); }
+
+  NodeDequePtr& NodeDequePtr::operator=(const NodeDequePtr& rhs) {
+    if (mpDeque != rhs.mpDeque) {
+      NodeDequePtr copy(rhs);
+      std::swap(mpDeque, copy.mpDeque);
+    }
+    return *this;
+  }
+
+  NodeDequePtr& NodeDequePtr::operator=(NodeDequePtr&& rhs) {
+    if (this != &rhs) {
+      release();
+      mpDeque = rhs.mpDeque;
+      rhs.mpDeque = NULL;
+    }
+    return *this;
+  }
+
+  NodeDequePtr NodeDequePtr::make() {
+    if (pool.free.empty()) return NodeDequePtr(new NodeDeque());
+    NodeDeque* pDeque = pool.free.back();
+    pool.free.pop_back();
+    return NodeDequePtr(pDeque);
+  }
+
+  NodeDequePtr NodeDequePtr::make(const NodeDeque& values) {
+    NodeDequePtr pDeque = make();
+    pDeque->assign(values.begin(), values.end());
+    return pDeque;
+  }
+
+  void NodeDequePtr::release() {
+    NodeDeque* pDeque = mpDeque;
+    mpDeque = NULL;
+    if (!pDeque || -- pDeque->mRefCount) return;
+    // releases the collections of the nodes too
+    pDeque->clear();
+    if (pool.free.size() < pool_size && pDeque->capacity() <= pool_capacity) {
+      pool.free.push_back(pDeque);
+    }
+    else {
+      delete pDeque;
+    }
+  }
+
 
   Node Node::createCombinator(const Complex_Selector::Combinator& combinator) {
     NodeDequePtr null;
@@ -28,13 +86,13 @@ namespace Sass {
 
 
   Node Node::createCollection() {
-    NodeDequePtr pEmptyCollection = std::make_shared<NodeDeque>();
+    NodeDequePtr pEmptyCollection = NodeDequePtr::make();
     return Node(COLLECTION, Complex_Selector::ANCESTOR_OF, NULL /*pSelector*/, pEmptyCollection);
   }
 
 
   Node Node::createCollection(const NodeDeque& values) {
-    NodeDequePtr pShallowCopiedCollection = std::make_shared<NodeDeque>(values);
+    NodeDequePtr pShallowCopiedCollection = NodeDequePtr::make(values);
     return Node(COLLECTION, Complex_Selector::ANCESTOR_OF, NULL /*pSelector*/, pShallowCopiedCollection);
   }
 
@@ -51,7 +109,7 @@ namespace Sass {
 
 
   Node Node::klone() const {
-    NodeDequePtr pNewCollection = std::make_shared<NodeDeque>();
+    NodeDequePtr pNewCollection = NodeDequePtr::make();
     if (mpCollection) {
       for (NodeDeque::iterator iter = mpCollection->begin(), iterEnd = mpCollection->end(); iter != iterEnd; iter++) {
         Node& toClone = *iter;
@@ -1,8 +1,7 @@
 #ifndef SASS_NODE_H
 #define SASS_NODE_H
 
-#include <deque>
-#include <memory>
+#include <vector>
 
 #include "ast.hpp"
 
@@ -31,8 +30,36 @@ namespace Sass {
    */
 
   class Node;
-  typedef std::deque<Node> NodeDeque;
-  typedef std::shared_ptr<NodeDeque> NodeDequePtr;
+  class NodeDeque;
+
+  // A shared reference to a collection (copies of a node share it, like ruby arrays).
+  // The count is not atomic, the nodes of an extend or unify never leave their thread.
+  class NodeDequePtr {
+  public:
+    NodeDequePtr() : mpDeque(NULL) {}
+    NodeDequePtr(const NodeDequePtr& rhs) : mpDeque(rhs.mpDeque) { retain(); }
+    NodeDequePtr(NodeDequePtr&& rhs) : mpDeque(rhs.mpDeque) { rhs.mpDeque = NULL; }
+    NodeDequePtr& operator=(const NodeDequePtr& rhs);
+    NodeDequePtr& operator=(NodeDequePtr&& rhs);
+    ~NodeDequePtr() { release(); }
+
+    // an empty collection, recycled from this thread if possible
+    static NodeDequePtr make();
+    static NodeDequePtr make(const NodeDeque& values);
+
+    NodeDeque* get() const { return mpDeque; }
+    NodeDeque* operator->() const { return mpDeque; }
+    NodeDeque& operator*() const { return *mpDeque; }
+    operator bool() const { return mpDeque != NULL; }
+    bool operator==(const NodeDequePtr& rhs) const { return mpDeque == rhs.mpDeque; }
+    bool operator!=(const NodeDequePtr& rhs) const { return mpDeque != rhs.mpDeque; }
+
+  private:
+    explicit NodeDequePtr(NodeDeque* pDeque);
+    inline void retain();
+    void release();
+    NodeDeque* mpDeque;
+  };
 
   class Node {
   public:
@@ -107,6 +134,22 @@ namespace Sass {
     NodeDequePtr mpCollection;
   };
 
+  // The nodes of a collection, in one contiguous array. Collections are short,
+  // so adding and removing at the front is not worth a deque (which allocates
+  // a block of 512 bytes even for an empty one). Released collections are kept
+  // for reuse on their thread, with the capacity of their array.
+  class NodeDeque : public std::vector<Node> {
+  public:
+    NodeDeque() : std::vector<Node>(), mRefCount(0) {}
+    void push_front(const Node& node) { insert(begin(), node); }
+    void pop_front() { erase(begin()); }
+  private:
+    friend class NodeDequePtr;
+    size_t mRefCount;
+  };
+
+  inline void NodeDequePtr::retain() { if (mpDeque) ++ mpDeque->mRefCount; }
+
 #ifdef DEBUG
   std::ostream& operator<<(std::ostream& os, const Node& node);
 #endif
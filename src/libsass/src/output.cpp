@@ -1,11 +1,14 @@
 #include "sass.hpp"
 #include "ast.hpp"
 #include "output.hpp"
+#include "error_handling.hpp"
 
 namespace Sass {
 
   Output::Output(Sass_Output_Options& opt)
   : Inspect(Emitter(opt)),
+    cancelled(0),
+    output_limit(0),
     charset(""),
     top_nodes(0)
   {}
@@ -86,6 +89,13 @@ namespace Sass {
 
   }
 
+  void Output::append_part(const Output& part)
+  {
+    append_output(part);
+    // imports and leading comments
+    top_nodes.insert(top_nodes.end(), part.top_nodes.begin(), part.top_nodes.end());
+  }
+
   void Output::operator()(Comment_Ptr c)
   {
     std::string txt = c->text()->to_string(opt);
@@ -110,6 +120,12 @@ namespace Sass {
 
   void Output::operator()(Ruleset_Ptr r)
   {
+    if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+      throw Exception::Cancelled();
+    }
+    if (output_limit && wbuf.buffer.size() > output_limit) {
+      throw Exception::LimitExceeded("output", output_limit);
+    }
     Selector_Obj s     = r->selector();
     Block_Obj    b     = r->block();
 
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <vector>
+#include <atomic>
 
 #include "util.hpp"
 #include "inspect.hpp"
@@ -26,12 +27,19 @@ namespace Sass {
     Output(Sass_Output_Options& opt);
     virtual ~Output();
 
+    // stops rendering at the next ruleset once set
+    const std::atomic<bool>* cancelled;
+    // bytes the buffer may grow to, zero for no limit
+    size_t output_limit;
+
   protected:
     std::string charset;
     std::vector<AST_Node_Ptr> top_nodes;
 
   public:
     OutputBuffer get_buffer(void);
+    // append an output that resumed from this one
+    void append_part(const Output& part);
 
     virtual void operator()(Map_Ptr);
     virtual void operator()(Ruleset_Ptr);
@@ -0,0 +1,234 @@
+#include "sass.hpp"
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+
+#include "parallel_extend.hpp"
+#include "context.hpp"
+#include "ast.hpp"
+
+namespace Sass {
+
+  // fewer children are not worth a thread
+  static const size_t min_chunk_size = 8;
+  // chunks per thread, to even out their sizes
+  static const size_t chunks_per_thread = 4;
+
+  Extend_Chunk::Extend_Chunk(size_t begin, size_t end, std::atomic<bool>* stopped)
+  : begin(begin), end(end), subset_map(), extend(), selectors(),
+    allocated_nodes(0), failed(false), stopped(stopped),
+    lists(), complexes(), compounds()
+  { }
+
+  Selector_List_Obj Extend_Chunk::clone(Selector_List_Ptr list)
+  {
+    Selector_List_Obj& cpy = lists[list];
+    if (!cpy) {
+      cpy = SASS_MEMORY_COPY(list);
+      for (size_t i = 0, L = cpy->length(); i < L; ++i) {
+        cpy->at(i) = clone(cpy->at(i));
+      }
+    }
+    return cpy;
+  }
+
+  Complex_Selector_Obj Extend_Chunk::clone(Complex_Selector_Ptr complex)
+  {
+    if (!complex) return complex;
+    Complex_Selector_Obj& cpy = complexes[complex];
+    if (!cpy) {
+      cpy = SASS_MEMORY_COPY(complex);
+      cpy->head(clone(complex->head()));
+      cpy->tail(clone(complex->tail()));
+    }
+    return cpy;
+  }
+
+  Compound_Selector_Obj Extend_Chunk::clone(Compound_Selector_Ptr compound)
+  {
+    if (!compound) return compound;
+    Compound_Selector_Obj& cpy = compounds[compound];
+    if (!cpy) {
+      cpy = SASS_MEMORY_COPY(compound);
+      for (size_t i = 0, L = cpy->length(); i < L; ++i) {
+        cpy->at(i) = SASS_MEMORY_CLONE(cpy->at(i));
+      }
+    }
+    return cpy;
+  }
+
+  void Extend_Chunk::serial_only()
+  {
+    throw Serial_Only();
+  }
+
+  void Extend_Chunk::stop()
+  {
+    stopped->store(true, std::memory_order_relaxed);
+    throw Serial_Only();
+  }
+
+  void Extend_Chunk::checkpoint()
+  {
+    if (stopped->load(std::memory_order_relaxed)) serial_only();
+  }
+
+  Parallel_Extend::Parallel_Extend(Context& ctx, Extend& extend, Eval& eval, size_t threads)
+  : ctx(ctx), serial(extend), eval(eval), threads(threads), chunks(), next_chunk(0), stopped(false)
+  { }
+
+  // the selectors of the rulesets in a statement, and those
+  // of them that are memoized when extended (lists and complexes)
+  static void collect(Statement_Ptr stm, std::vector<Selector_Ptr>& selectors, std::vector<Selector_Ptr>& memoized)
+  {
+    if (Ruleset_Ptr rule = Cast<Ruleset>(stm)) {
+      if (Selector_List_Ptr list = rule->selector()) {
+        selectors.push_back(list);
+        memoized.push_back(list);
+        for (Complex_Selector_Obj complex : list->elements()) {
+          memoized.push_back(complex);
+          for (Complex_Selector_Ptr cur = complex; cur; cur = cur->tail()) {
+            selectors.push_back(cur);
+            if (cur->head()) selectors.push_back(cur->head());
+          }
+        }
+      }
+    }
+    if (Has_Block_Ptr parent = Cast<Has_Block>(stm)) {
+      if (Block_Ptr block = parent->block()) {
+        for (Statement_Obj child : block->elements()) {
+          collect(child, selectors, memoized);
+        }
+      }
+    }
+  }
+
+  // links the child to the previous one with the same key (in owner)
+  static void link(std::vector<long>& links, size_t& owner, size_t child)
+  {
+    // owners are stored with an offset, zero is no owner yet
+    if (owner && owner - 1 != child) {
+      ++ links[owner];
+      -- links[child + 1];
+    }
+    owner = child + 1;
+  }
+
+  void Parallel_Extend::split(Block_Ptr root)
+  {
+    size_t length = root->length();
+    size_t count = std::min(threads * chunks_per_thread, length / min_chunk_size);
+    if (count < 2) return;
+
+    // extending changes the selectors in place, children sharing
+    // some (like bubbled rulesets) must not be in different chunks
+    std::vector<long> links(length + 1, 0);
+    std::unordered_map<Selector_Ptr, size_t> owners;
+    // and the results are memoized, children with equal selectors
+    // are kept together to not have both chunks extended again
+    // (compared as strings, hashing would cache the hashes)
+    std::unordered_map<std::string, size_t> values;
+    std::vector<Selector_Ptr> selectors, memoized;
+    for (size_t i = 0; i < length; ++i) {
+      selectors.clear();
+      memoized.clear();
+      collect(root->at(i), selectors, memoized);
+      for (Selector_Ptr selector : selectors) {
+        link(links, owners[selector], i);
+      }
+      for (Selector_Ptr selector : memoized) {
+        link(links, values[selector->to_string()], i);
+      }
+    }
+    // no links may span a cut
+    for (size_t i = 1; i <= length; ++i) links[i] += links[i - 1];
+
+    size_t begin = 0;
+    for (size_t i = 1; i <= count && begin < length; ++i) {
+      size_t end = i == count ? length : std::max(begin + 1, length * i / count);
+      while (end < length && links[end] > 0) ++ end;
+      chunks.push_back(std::unique_ptr<Extend_Chunk>(new Extend_Chunk(begin, end, &stopped)));
+      begin = end;
+    }
+  }
+
+  bool Parallel_Extend::run(Block_Ptr root)
+  {
+    if (!root->is_root()) return false;
+    split(root);
+    if (chunks.size() < 2) return false;
+
+    std::vector<std::thread> pool;
+    try {
+      for (size_t i = 0; i < threads && i < chunks.size(); ++i) {
+        pool.push_back(std::thread(&Parallel_Extend::work, this, root));
+      }
+    }
+    catch (std::system_error&) {
+      // run with the threads we got, or extend on this one
+    }
+    for (std::thread& thread : pool) thread.join();
+
+    for (auto& chunk : chunks) {
+      if (chunk->extend && !chunk->failed && !serial.memoizedAny(*chunk->extend)) {
+        take(*chunk);
+      }
+      else {
+        for (size_t i = chunk->begin; i < chunk->end; ++i) {
+          root->at(i)->perform(&serial);
+        }
+      }
+      chunk.reset();
+    }
+    serial.checkExtended();
+    return true;
+  }
+
+  void Parallel_Extend::work(Block_Ptr root)
+  {
+    for (size_t i = next_chunk ++; i < chunks.size(); i = next_chunk ++) {
+      if (stopped.load(std::memory_order_relaxed)) break;
+      extend(root, *chunks[i]);
+    }
+  }
+
+  void Parallel_Extend::extend(Block_Ptr root, Extend_Chunk& chunk)
+  {
+    size_t allocated = SharedObj::getAllocated();
+    try {
+      chunk.subset_map.reset(ctx.subset_map.clone());
+      chunk.extend.reset(new Extend(*chunk.subset_map, &chunk));
+      chunk.extend->setEval(eval);
+      for (size_t i = chunk.begin; i < chunk.end; ++i) {
+        chunk.checkpoint();
+        root->at(i)->perform(chunk.extend.get());
+      }
+    }
+    catch (Extend_Chunk::Serial_Only&) {
+      // extended again in order
+      chunk.failed = true;
+    }
+    catch (...) {
+      // extended again in order, to report the error
+      chunk.failed = true;
+      stopped.store(true, std::memory_order_relaxed);
+    }
+    chunk.allocated_nodes = SharedObj::getAllocated() - allocated;
+  }
+
+  void Parallel_Extend::take(Extend_Chunk& chunk)
+  {
+    for (auto& it : chunk.selectors) it.first->selector(it.second);
+    // the pairs are at the same positions in the clone
+    const std::vector<SubSetMapPair>& values(ctx.subset_map.values());
+    const std::vector<SubSetMapPair>& cloned(chunk.subset_map->values());
+    for (size_t i = 0, L = values.size(); i < L; ++i) {
+      if (cloned[i].second->extended()) values[i].second->extended(true);
+    }
+    ctx.subset_map.lookups += chunk.subset_map->lookups;
+    ctx.stats.allocated_nodes += chunk.allocated_nodes;
+    serial.memoize(*chunk.extend);
+  }
+
+}
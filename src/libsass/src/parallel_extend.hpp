@@ -0,0 +1,96 @@
+#ifndef SASS_PARALLEL_EXTEND_H
+#define SASS_PARALLEL_EXTEND_H
+
+#include <atomic>
+#include <stdexcept>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+#include "sass.hpp"
+#include "ast_fwd_decl.hpp"
+#include "extend.hpp"
+#include "subset_map.hpp"
+
+namespace Sass {
+
+  class Context;
+
+  // A part of the root block, extended on another thread. It works
+  // on clones of the subset map and of the selectors of its rulesets
+  // and keeps the extended selectors back, the tree is only changed
+  // once all threads are done.
+  struct Extend_Chunk {
+    size_t begin;
+    size_t end;
+    std::unique_ptr<Subset_Map> subset_map;
+    std::unique_ptr<Extend> extend;
+    // the selectors for its rulesets, in the order they were extended
+    std::vector<std::pair<Ruleset_Ptr, Selector_List_Obj>> selectors;
+    size_t allocated_nodes;
+    bool failed;
+    // set once any chunk failed with an error
+    std::atomic<bool>* stopped;
+    Extend_Chunk(size_t begin, size_t end, std::atomic<bool>* stopped);
+    // a deep clone, sharing its parts with the other
+    // clones of the chunk like the original does
+    Selector_List_Obj clone(Selector_List_Ptr list);
+    // throws to have the chunk extended on the main thread
+    void serial_only();
+    // throws to stop all chunks, as the main thread will
+    // raise the error once it extends this chunk again
+    void stop();
+    // throws once another chunk failed with an error
+    void checkpoint();
+    struct Serial_Only : std::runtime_error {
+      Serial_Only() : std::runtime_error("needs to be extended on the main thread") { }
+    };
+  private:
+    Complex_Selector_Obj clone(Complex_Selector_Ptr complex);
+    Compound_Selector_Obj clone(Compound_Selector_Ptr compound);
+    std::unordered_map<Selector_List_Ptr, Selector_List_Obj> lists;
+    std::unordered_map<Complex_Selector_Ptr, Complex_Selector_Obj> complexes;
+    std::unordered_map<Compound_Selector_Ptr, Compound_Selector_Obj> compounds;
+  };
+
+  // Extends the root block in chunks on a pool of threads. The chunks
+  // are taken over in order: the extended selectors are set on their
+  // rulesets, the `extended` flags on the subset map and the memoized
+  // selectors on the extend of the main thread. Children that share
+  // selectors, or have equal ones, are kept in one chunk. A chunk is
+  // extended again on the main thread if it failed, needed the evaluator
+  // (for an extended :not) or memoized a selector an earlier chunk
+  // memoized already, as the earlier result would have been used
+  // without threads. So the result is exactly the same.
+  class Parallel_Extend {
+
+  public:
+    Parallel_Extend(Context& ctx, Extend& extend, Eval& eval, size_t threads);
+
+    // extends the root block and checks that all @extends matched,
+    // false if it has too few children to be split up
+    bool run(Block_Ptr root);
+
+  private:
+    void split(Block_Ptr root);
+    void work(Block_Ptr root);
+    void extend(Block_Ptr root, Extend_Chunk& chunk);
+    void take(Extend_Chunk& chunk);
+
+    Context& ctx;
+    Extend& serial;
+    Eval& eval;
+    size_t threads;
+    std::vector<std::unique_ptr<Extend_Chunk>> chunks;
+    // the next chunk for a thread to extend
+    std::atomic<size_t> next_chunk;
+    // set by the first chunk failing with an error, the others
+    // stop at their next checkpoint instead of extending on (the
+    // chunks before it are extended again on the main thread)
+    std::atomic<bool> stopped;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,113 @@
+#include "sass.hpp"
+#include <thread>
+#include <algorithm>
+#include <system_error>
+
+#include "parallel_output.hpp"
+#include "context.hpp"
+#include "ast.hpp"
+
+namespace Sass {
+
+  // fewer children are not worth a thread
+  static const size_t min_part_size = 16;
+  // parts per thread, to even out their sizes
+  static const size_t parts_per_thread = 4;
+
+  Parallel_Output::Part::Part(size_t begin, size_t end, const Sass_Output_Options& opt)
+  : begin(begin), end(end), opt(opt), output(), allocated_nodes(0), failed(false)
+  { }
+
+  Parallel_Output::Parallel_Output(Context& ctx, size_t threads)
+  : ctx(ctx), threads(threads), parts(), next_part(1)
+  { }
+
+  void Parallel_Output::split(Block_Ptr root)
+  {
+    size_t length = root->length();
+    size_t count = std::min(threads * parts_per_thread, length / min_part_size);
+    size_t begin = 0;
+    for (size_t i = 1; i <= count && begin < length; ++i) {
+      size_t end = i == count ? length : length * i / count;
+      // parts are cut after a ruleset or media block, the
+      // others are more likely to leave another state behind
+      while (end < length && end > begin) {
+        Statement_Ptr last = root->at(end - 1);
+        if (Cast<Ruleset>(last) || Cast<Media_Block>(last)) break;
+        ++ end;
+      }
+      if (end <= begin) continue;
+      parts.push_back(std::unique_ptr<Part>(new Part(begin, end, ctx.c_options)));
+      begin = end;
+    }
+  }
+
+  bool Parallel_Output::run(Block_Ptr root)
+  {
+    Output& emitter = ctx.emitter;
+    if (!root->is_root()) return false;
+    split(root);
+    if (parts.size() < 2) return false;
+
+    // the root block as rendered by inspect
+    if (emitter.output_style() == NESTED) emitter.indentation += root->tabs();
+    for (size_t i = parts[0]->begin; i < parts[0]->end; ++i) {
+      root->at(i)->perform(&emitter);
+    }
+
+    Emitter::State state = emitter.state();
+    std::vector<std::thread> pool;
+    try {
+      for (size_t i = 0; i < threads && i + 1 < parts.size(); ++i) {
+        pool.push_back(std::thread(&Parallel_Output::work, this, root, state));
+      }
+    }
+    catch (std::system_error&) {
+      // run with the threads we got, or render on this one
+    }
+    for (std::thread& thread : pool) thread.join();
+
+    for (size_t i = 1; i < parts.size(); ++i) {
+      Part& part = *parts[i];
+      if (part.output && !part.failed && emitter.state() == state) {
+        emitter.append_part(*part.output);
+        ctx.stats.allocated_nodes += part.allocated_nodes;
+      }
+      else {
+        for (size_t n = part.begin; n < part.end; ++n) {
+          root->at(n)->perform(&emitter);
+        }
+      }
+      part.output.reset();
+    }
+    if (emitter.output_style() == NESTED) emitter.indentation -= root->tabs();
+    return true;
+  }
+
+  void Parallel_Output::work(Block_Ptr root, const Emitter::State& state)
+  {
+    for (size_t i = next_part ++; i < parts.size(); i = next_part ++) {
+      render(root, *parts[i], state);
+    }
+  }
+
+  void Parallel_Output::render(Block_Ptr root, Part& part, const Emitter::State& state)
+  {
+    size_t allocated = SharedObj::getAllocated();
+    try {
+      part.output.reset(new Output(part.opt));
+      part.output->cancelled = ctx.emitter.cancelled;
+      part.output->output_limit = ctx.emitter.output_limit;
+      part.output->resume(state);
+      for (size_t i = part.begin; i < part.end; ++i) {
+        root->at(i)->perform(part.output.get());
+      }
+    }
+    catch (...) {
+      // rendered again in order, to report the error
+      part.failed = true;
+    }
+    part.allocated_nodes = SharedObj::getAllocated() - allocated;
+  }
+
+}
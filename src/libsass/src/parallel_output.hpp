@@ -0,0 +1,57 @@
+#ifndef SASS_PARALLEL_OUTPUT_H
+#define SASS_PARALLEL_OUTPUT_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "sass.hpp"
+#include "ast_fwd_decl.hpp"
+#include "output.hpp"
+
+namespace Sass {
+
+  class Context;
+
+  // Renders the root block in parts on a pool of threads. The first
+  // part is rendered as usual, the others resume from the state it
+  // ended in (the state after a top level ruleset or media block).
+  // Parts are appended in order; a part that started from another
+  // state than the previous one ended in (or failed) is rendered
+  // again on the main thread, so the output is exactly the same.
+  class Parallel_Output {
+
+  public:
+    Parallel_Output(Context& ctx, size_t threads);
+
+    // renders the root block into the emitter of the context,
+    // false if it has too few children to be split up
+    bool run(Block_Ptr root);
+
+  private:
+    struct Part {
+      size_t begin;
+      size_t end;
+      // a copy, inspect toggles some flags while rendering
+      Sass_Output_Options opt;
+      std::unique_ptr<Output> output;
+      size_t allocated_nodes;
+      bool failed;
+      Part(size_t begin, size_t end, const Sass_Output_Options& opt);
+    };
+
+    void split(Block_Ptr root);
+    void work(Block_Ptr root, const Emitter::State& state);
+    void render(Block_Ptr root, Part& part, const Emitter::State& state);
+
+    Context& ctx;
+    size_t threads;
+    std::vector<std::unique_ptr<Part>> parts;
+    // the next part for a thread to render
+    std::atomic<size_t> next_part;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,204 @@
+#include "sass.hpp"
+#include <thread>
+#include <cstdlib>
+#include <stdexcept>
+#include <system_error>
+
+#include "parallel_parse.hpp"
+#include "context.hpp"
+#include "parser.hpp"
+#include "check_nesting.hpp"
+#include "stats.hpp"
+
+namespace Sass {
+
+  thread_local Parallel_Parse* Parallel_Parse::active = 0;
+  thread_local Parsed_Import* Parallel_Parse::current = 0;
+  thread_local size_t Parallel_Parse::thread_id = 0;
+
+  Parsed_Import::Parsed_Import(const Resource& resource, char* path, size_t index)
+  : resource(resource), path(path), index(index), root(), imports(),
+    parse_ms(0), allocated_nodes(0), taken(false)
+  { }
+
+  Parallel_Parse::Parallel_Parse(Context& ctx, size_t threads)
+  : ctx(ctx), threads(threads), queues(), mutex(), wake(), files(), entry(0),
+    next_index(0), queued(0), pending(0), failed(false)
+  {
+    for (size_t i = 0; i < threads; ++i) {
+      queues.push_back(std::unique_ptr<Queue>(new Queue()));
+    }
+  }
+
+  Parallel_Parse::~Parallel_Parse()
+  {
+    for (auto& it : files) {
+      Parsed_Import* file = it.second.get();
+      // release the tree before the buffers it points into
+      file->root = Block_Obj();
+      file->imports.clear();
+      if (file->taken) continue;
+      free(file->path);
+      // the entry is still owned by the context
+      if (file == entry) continue;
+      free(file->resource.contents);
+      free(file->resource.srcmap);
+    }
+  }
+
+  Parallel_Parse* Parallel_Parse::worker()
+  {
+    return active;
+  }
+
+  void Parallel_Parse::serial_only()
+  {
+    if (active) throw std::runtime_error("needs to be parsed on the main thread");
+  }
+
+  bool Parallel_Parse::run(const Include& include, const Resource& res)
+  {
+    Stats_Clock::time_point start = Stats_Clock::now();
+    // imports get the slots after the entry in the order they are found
+    next_index = ctx.resources.size();
+    entry = new Parsed_Import(res, sass_copy_c_string(include.abs_path.c_str()), next_index ++);
+    files[include.abs_path].reset(entry);
+    submit(entry);
+
+    std::vector<std::thread> pool;
+    try {
+      for (size_t i = 0; i < threads; ++i) {
+        pool.push_back(std::thread(&Parallel_Parse::work, this, i));
+      }
+    }
+    catch (std::system_error&) {
+      // run with the threads we got
+      if (pool.empty()) failed = true;
+    }
+    for (std::thread& thread : pool) thread.join();
+
+    ctx.stats.parse += elapsed_ms(start);
+    return !failed;
+  }
+
+  Parsed_Import* Parallel_Parse::take(const std::string& abs_path)
+  {
+    auto it = files.find(abs_path);
+    if (it == files.end() || it->second->taken) return 0;
+    it->second->taken = true;
+    return it->second.get();
+  }
+
+  Resource Parallel_Parse::resource(const std::string& abs_path)
+  {
+    Parsed_Import* file = files.at(abs_path).get();
+    if (!file->taken) return file->resource;
+    // only registered twice for an @import loop, which raises the error
+    return { sass_copy_c_string(file->resource.contents), 0 };
+  }
+
+  void Parallel_Parse::import(const Include& include, const ParserState& pstate)
+  {
+    current->imports.push_back(std::make_pair(include, pstate));
+    Parsed_Import* file = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      std::unique_ptr<Parsed_Import>& known = files[include.abs_path];
+      // parsed only once, like the context does without custom importers
+      if (known) return;
+      file = new Parsed_Import({ 0, 0 }, sass_copy_c_string(include.abs_path.c_str()), next_index ++);
+      known.reset(file);
+    }
+    submit(file);
+  }
+
+  void Parallel_Parse::submit(Parsed_Import* file)
+  {
+    ++ pending;
+    ++ queued;
+    {
+      Queue& queue = *queues[thread_id];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.files.push_back(file);
+    }
+    // a thread about to sleep has checked `queued` under the lock
+    { std::lock_guard<std::mutex> lock(mutex); }
+    wake.notify_one();
+  }
+
+  Parsed_Import* Parallel_Parse::next(size_t thread)
+  {
+    // the newest file of the own queue first
+    {
+      Queue& own = *queues[thread];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.files.empty()) {
+        Parsed_Import* file = own.files.back();
+        own.files.pop_back();
+        -- queued;
+        return file;
+      }
+    }
+    // then steal the oldest file of another thread
+    for (size_t i = 1; i < threads; ++i) {
+      Queue& other = *queues[(thread + i) % threads];
+      std::lock_guard<std::mutex> lock(other.mutex);
+      if (!other.files.empty()) {
+        Parsed_Import* file = other.files.front();
+        other.files.pop_front();
+        -- queued;
+        return file;
+      }
+    }
+    return 0;
+  }
+
+  void Parallel_Parse::work(size_t thread)
+  {
+    active = this;
+    thread_id = thread;
+    while (!failed) {
+      if (Parsed_Import* file = next(thread)) {
+        parse(file);
+        if (-- pending == 0) {
+          std::lock_guard<std::mutex> lock(mutex);
+          wake.notify_all();
+        }
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [this] { return queued > 0 || pending == 0 || failed; });
+      if (pending == 0) break;
+    }
+    active = 0;
+  }
+
+  void Parallel_Parse::parse(Parsed_Import* file)
+  {
+    size_t allocated = SharedObj::getAllocated();
+    Stats_Clock::time_point start = Stats_Clock::now();
+    current = file;
+    try {
+      // the entry was loaded by the context
+      if (file != entry) file->resource.contents = File::read_file(file->path);
+      if (!file->resource.contents) throw std::runtime_error("unreadable");
+      ParserState pstate(file->path, file->resource.contents, file->index);
+      Parser p(Parser::from_c_str(file->resource.contents, ctx, ctx.traces, pstate));
+      file->root = p.parse();
+      if (!ctx.parse_only || ctx.shared_parse) {
+        CheckNesting check_nesting;
+        check_nesting(file->root);
+      }
+    }
+    catch (...) {
+      // the context reports it in order when parsing again
+      failed = true;
+      std::lock_guard<std::mutex> lock(mutex);
+      wake.notify_all();
+    }
+    current = 0;
+    file->parse_ms = elapsed_ms(start);
+    file->allocated_nodes = SharedObj::getAllocated() - allocated;
+  }
+
+}
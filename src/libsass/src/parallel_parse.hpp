@@ -0,0 +1,99 @@
+#ifndef SASS_PARALLEL_PARSE_H
+#define SASS_PARALLEL_PARSE_H
+
+#include <map>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <condition_variable>
+
+#include "ast_fwd_decl.hpp"
+#include "position.hpp"
+#include "file.hpp"
+
+namespace Sass {
+
+  class Context;
+
+  // A file parsed ahead of its registration. The parser state of its
+  // nodes refers to `index`, the resource slot reserved on discovery.
+  struct Parsed_Import {
+    Resource resource;
+    // path of the parser states, handed over to the context
+    char* path;
+    size_t index;
+    Block_Obj root;
+    // files this one imports, in the order the parser found them
+    std::vector<std::pair<Include, ParserState>> imports;
+    double parse_ms;
+    size_t allocated_nodes;
+    // the resource was handed to the context or came from it
+    bool taken;
+    Parsed_Import(const Resource& resource, char* path, size_t index);
+  };
+
+  // Parses the entry file and everything it imports on a pool of
+  // threads. Each thread takes files from its own queue and steals
+  // from the others once that runs dry. Imports found by the parser
+  // are queued instead of being parsed recursively. Files are then
+  // registered by the context in the usual order. Anything that has
+  // to happen in that order (errors, warnings) fails the whole run,
+  // the context then parses the files the usual way.
+  class Parallel_Parse {
+
+  public:
+    Parallel_Parse(Context& ctx, size_t threads);
+    ~Parallel_Parse();
+
+    // parses the entry and its imports, false if any of them failed
+    bool run(const Include& entry, const Resource& res);
+    // the file for registration (only handed out once)
+    Parsed_Import* take(const std::string& abs_path);
+    // the resource of a file, a copy if it was taken already
+    Resource resource(const std::string& abs_path);
+
+    // the run the current thread works for, if any
+    static Parallel_Parse* worker();
+    // fails the run of the current thread, if any
+    static void serial_only();
+    // called by the context for an import found by a worker
+    void import(const Include& include, const ParserState& pstate);
+
+  private:
+    struct Queue {
+      std::mutex mutex;
+      std::deque<Parsed_Import*> files;
+    };
+
+    void submit(Parsed_Import* file);
+    Parsed_Import* next(size_t thread);
+    void work(size_t thread);
+    void parse(Parsed_Import* file);
+
+    Context& ctx;
+    size_t threads;
+    std::vector<std::unique_ptr<Queue>> queues;
+    // guards files, next_index and sleeping threads
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::map<std::string, std::unique_ptr<Parsed_Import>> files;
+    Parsed_Import* entry;
+    size_t next_index;
+    // files queued but not yet taken by a thread
+    std::atomic<size_t> queued;
+    // files queued but not yet parsed
+    std::atomic<size_t> pending;
+    std::atomic<bool> failed;
+
+    static thread_local Parallel_Parse* active;
+    static thread_local Parsed_Import* current;
+    static thread_local size_t thread_id;
+
+  };
+
+}
+
+#endif
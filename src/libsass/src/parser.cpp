@@ -4,6 +4,7 @@
 #include "inspect.hpp"
 #include "constants.hpp"
 #include "util.hpp"
+#include "parallel_parse.hpp"
 #include "prelexer.hpp"
 #include "color_maps.hpp"
 #include "sass/functions.h"
@@ -186,6 +187,8 @@ namespace Sass {
     // loop until end of string
     while (position < end) {
 
+      ctx.checkpoint();
+
       // we should be able to refactor this
       parse_block_comments();
       lex < css_whitespace >();
@@ -1661,6 +1664,8 @@ namespace Sass {
     if (lex< ampersand >())
     {
       if (match< ampersand >()) {
+        // warnings of a parallel parse would be printed out of order
+        Parallel_Parse::serial_only();
         warning("In Sass, \"&&\" means two copies of the parent selector. You probably want to use \"and\" instead.", pstate);
       }
       return SASS_MEMORY_NEW(Parent_Selector, pstate); }
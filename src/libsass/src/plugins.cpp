@@ -1,4 +1,6 @@
 #include "sass.hpp"
+#include <map>
+#include <mutex>
 #include <iostream>
 #include "output.hpp"
 #include "plugins.hpp"
@@ -50,14 +52,25 @@ namespace Sass {
 
   }
 
-  // load one specific plugin
-  bool Plugins::load_plugin (const std::string& path)
-  {
+  typedef const char* (*__plugin_version__)(void);
+  typedef Sass_Function_List (*__plugin_load_fns__)(void);
+  typedef Sass_Importer_List (*__plugin_load_imps__)(void);
+
+  // entry points of a loaded plugin library
+  struct Plugin_Library {
+    __plugin_load_fns__ load_functions;
+    __plugin_load_imps__ load_importers;
+    __plugin_load_imps__ load_headers;
+  };
 
-    typedef const char* (*__plugin_version__)(void);
-    typedef Sass_Function_List (*__plugin_load_fns__)(void);
-    typedef Sass_Importer_List (*__plugin_load_imps__)(void);
+  // Libraries are opened once per process and stay loaded, every
+  // context only asks them for its own functions and importers.
+  static std::mutex libraries_mutex;
+  static std::map<std::string, Plugin_Library> libraries;
 
+  // open a plugin library and look up its entry points
+  static bool open_plugin(const std::string& path, Plugin_Library& library)
+  {
     if (LOAD_LIB(plugin, path))
     {
       // try to load initial function to query libsass version suppor
@@ -66,26 +79,14 @@ namespace Sass {
         // get the libsass version of the plugin
         if (!compatibility(plugin_version())) return false;
         // try to get import address for "libsass_load_functions"
-        if (LOAD_LIB_FN(__plugin_load_fns__, plugin_load_functions, "libsass_load_functions"))
-        {
-          Sass_Function_List fns = plugin_load_functions(), _p = fns;
-          while (fns && *fns) { functions.push_back(*fns); ++ fns; }
-          sass_free_memory(_p); // only delete the container, items not yet
-        }
+        LOAD_LIB_FN(__plugin_load_fns__, plugin_load_functions, "libsass_load_functions");
         // try to get import address for "libsass_load_importers"
-        if (LOAD_LIB_FN(__plugin_load_imps__, plugin_load_importers, "libsass_load_importers"))
-        {
-          Sass_Importer_List imps = plugin_load_importers(), _p = imps;
-          while (imps && *imps) { importers.push_back(*imps); ++ imps; }
-          sass_free_memory(_p); // only delete the container, items not yet
-        }
+        LOAD_LIB_FN(__plugin_load_imps__, plugin_load_importers, "libsass_load_importers");
         // try to get import address for "libsass_load_headers"
-        if (LOAD_LIB_FN(__plugin_load_imps__, plugin_load_headers, "libsass_load_headers"))
-        {
-          Sass_Importer_List imps = plugin_load_headers(), _p = imps;
-          while (imps && *imps) { headers.push_back(*imps); ++ imps; }
-          sass_free_memory(_p); // only delete the container, items not yet
-        }
+        LOAD_LIB_FN(__plugin_load_imps__, plugin_load_headers, "libsass_load_headers");
+        library.load_functions = plugin_load_functions;
+        library.load_importers = plugin_load_importers;
+        library.load_headers = plugin_load_headers;
         // success
         return true;
       }
@@ -105,7 +106,40 @@ namespace Sass {
     }
 
     return false;
+  }
+
+  // load one specific plugin
+  bool Plugins::load_plugin (const std::string& path)
+  {
+    Plugin_Library library;
+    {
+      std::lock_guard<std::mutex> lock(libraries_mutex);
+      auto it = libraries.find(path);
+      if (it != libraries.end()) library = it->second;
+      else if (open_plugin(path, library)) libraries[path] = library;
+      else return false;
+    }
+
+    if (library.load_functions)
+    {
+      Sass_Function_List fns = library.load_functions(), _p = fns;
+      while (fns && *fns) { functions.push_back(*fns); ++ fns; }
+      sass_free_memory(_p); // only delete the container, items not yet
+    }
+    if (library.load_importers)
+    {
+      Sass_Importer_List imps = library.load_importers(), _p = imps;
+      while (imps && *imps) { importers.push_back(*imps); ++ imps; }
+      sass_free_memory(_p); // only delete the container, items not yet
+    }
+    if (library.load_headers)
+    {
+      Sass_Importer_List imps = library.load_headers(), _p = imps;
+      while (imps && *imps) { headers.push_back(*imps); ++ imps; }
+      sass_free_memory(_p); // only delete the container, items not yet
+    }
 
+    return true;
   }
 
   size_t Plugins::load_plugins(const std::string& path)
@@ -0,0 +1,125 @@
+#include "sass.hpp"
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+
+#include "ast.hpp"
+#include "json.hpp"
+#include "profiler.hpp"
+
+namespace Sass {
+
+  static const char* type_name(enum Sass_Callee_Type type)
+  {
+    switch (type) {
+      case SASS_CALLEE_MIXIN: return "mixin";
+      case SASS_CALLEE_FUNCTION: return "function";
+      case SASS_CALLEE_C_FUNCTION: return "c function";
+    }
+    return "unknown";
+  }
+
+  Profiler::Profiler(enum Sass_Profile_Style style)
+  : style_(style), origin_(Stats_Clock::now()),
+    entries_(), index_(), stack_(), events_()
+  { }
+
+  void Profiler::enter(Definition_Ptr def, const std::string& name, enum Sass_Callee_Type type)
+  {
+    const ParserState& pstate = def->pstate();
+    std::string path(pstate.path ? pstate.path : "");
+    std::stringstream key;
+    key << type << ':' << name << '@' << path << ':' << pstate.line;
+    auto it = index_.find(key.str());
+    size_t idx = entries_.size();
+    if (it == index_.end()) {
+      index_[key.str()] = idx;
+      entries_.push_back({ name, type, path, pstate.line + 1, 0, 0, 0, 0 });
+    }
+    else {
+      idx = it->second;
+    }
+    ++ entries_[idx].calls;
+    ++ entries_[idx].active;
+    stack_.push_back({ idx, Stats_Clock::now(), 0 });
+  }
+
+  void Profiler::exit()
+  {
+    if (stack_.empty()) return;
+    Frame frame = stack_.back();
+    stack_.pop_back();
+    double ms = elapsed_ms(frame.start);
+    Entry& entry = entries_[frame.entry];
+    entry.exclusive += ms - frame.children;
+    // don't count recursive calls twice
+    if (-- entry.active == 0) entry.inclusive += ms;
+    if (!stack_.empty()) stack_.back().children += ms;
+    if (style_ == SASS_PROFILE_TRACE) {
+      std::chrono::duration<double, std::micro> ts(frame.start - origin_);
+      events_.push_back({ frame.entry, ts.count(), ms * 1000 });
+    }
+  }
+
+  std::string Profiler::render() const
+  {
+    if (style_ == SASS_PROFILE_TRACE) return render_trace();
+    if (style_ == SASS_PROFILE_FLAT) return render_flat();
+    return "";
+  }
+
+  // table sorted by exclusive time
+  std::string Profiler::render_flat() const
+  {
+    std::vector<const Entry*> sorted;
+    for (const Entry& entry : entries_) sorted.push_back(&entry);
+    std::stable_sort(sorted.begin(), sorted.end(),
+      [](const Entry* a, const Entry* b) { return a->exclusive > b->exclusive; });
+    std::stringstream out;
+    out << std::fixed << std::setprecision(3);
+    out << std::setw(8) << "calls" << std::setw(14) << "inclusive ms"
+        << std::setw(14) << "exclusive ms" << "  name" << "\n";
+    for (const Entry* entry : sorted) {
+      out << std::setw(8) << entry->calls
+          << std::setw(14) << entry->inclusive
+          << std::setw(14) << entry->exclusive
+          << "  " << entry->name << " (" << type_name(entry->type);
+      if (entry->path.size() && entry->path[0] != '[') {
+        out << ", " << entry->path << ":" << entry->line;
+      }
+      out << ")\n";
+    }
+    return out.str();
+  }
+
+  // complete events as understood by chrome://tracing
+  std::string Profiler::render_trace() const
+  {
+    JsonNode* json = json_mkobject();
+    JsonNode* events = json_mkarray();
+    for (const Event& event : events_) {
+      const Entry& entry = entries_[event.entry];
+      JsonNode* node = json_mkobject();
+      json_append_member(node, "name", json_mkstring(entry.name.c_str()));
+      json_append_member(node, "cat", json_mkstring(type_name(entry.type)));
+      json_append_member(node, "ph", json_mkstring("X"));
+      json_append_member(node, "ts", json_mknumber(event.ts));
+      json_append_member(node, "dur", json_mknumber(event.dur));
+      json_append_member(node, "pid", json_mknumber(1));
+      json_append_member(node, "tid", json_mknumber(1));
+      JsonNode* args = json_mkobject();
+      json_append_member(args, "file", json_mkstring(entry.path.c_str()));
+      json_append_member(args, "line", json_mknumber((double)entry.line));
+      json_append_member(node, "args", args);
+      json_append_element(events, node);
+    }
+    json_append_member(json, "traceEvents", events);
+    json_append_member(json, "displayTimeUnit", json_mkstring("ms"));
+    char* str = json_stringify(json, NULL);
+    std::string trace(str ? str : "");
+    free(str);
+    json_delete(json);
+    return trace;
+  }
+
+}
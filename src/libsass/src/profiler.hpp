@@ -0,0 +1,80 @@
+#ifndef SASS_PROFILER_H
+#define SASS_PROFILER_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "sass/base.h"
+#include "sass/functions.h"
+#include "ast_fwd_decl.hpp"
+#include "stats.hpp"
+
+namespace Sass {
+
+  // Records calls and time spent per function and mixin definition.
+  // Only created if a profile was requested, so call sites check
+  // the pointer on the context before calling into it.
+  class Profiler {
+
+  public:
+
+    struct Entry {
+      std::string name;
+      enum Sass_Callee_Type type;
+      // location of the definition
+      std::string path;
+      size_t line;
+      size_t calls;
+      // time including nested calls (outermost recursion only)
+      double inclusive;
+      // time excluding nested calls
+      double exclusive;
+      // open invocations (recursion depth)
+      size_t active;
+    };
+
+  private:
+
+    struct Frame {
+      size_t entry;
+      Stats_Clock::time_point start;
+      // time spent in nested calls
+      double children;
+    };
+
+    // one finished call for the trace (microseconds)
+    struct Event {
+      size_t entry;
+      double ts;
+      double dur;
+    };
+
+    enum Sass_Profile_Style style_;
+    Stats_Clock::time_point origin_;
+    std::vector<Entry> entries_;
+    // entries by name and definition location
+    std::unordered_map<std::string, size_t> index_;
+    std::vector<Frame> stack_;
+    std::vector<Event> events_;
+
+    std::string render_flat() const;
+    std::string render_trace() const;
+
+  public:
+
+    Profiler(enum Sass_Profile_Style style);
+
+    void enter(Definition_Ptr def, const std::string& name, enum Sass_Callee_Type type);
+    void exit();
+
+    const std::vector<Entry>& entries() const { return entries_; }
+
+    // report in the requested style
+    std::string render() const;
+
+  };
+
+}
+
+#endif
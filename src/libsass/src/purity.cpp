@@ -0,0 +1,239 @@
+#include "sass.hpp"
+#include <algorithm>
+
+#include "ast.hpp"
+#include "util.hpp"
+#include "purity.hpp"
+#include "environment.hpp"
+
+namespace Sass {
+
+  static void add_unique(std::vector<std::string>& names, const std::string& name)
+  {
+    if (std::find(names.begin(), names.end(), name) == names.end()) {
+      names.push_back(name);
+    }
+  }
+
+  // walk an expression and gather variables and function calls
+  // returns false on anything we don't know to be side-effect free
+  static bool analyse(Expression_Ptr ex, Purity::Summary& s)
+  {
+    if (!ex) return true;
+    if (Variable_Ptr var = Cast<Variable>(ex)) {
+      add_unique(s.variables, var->name());
+      return true;
+    }
+    if (Function_Call_Ptr call = Cast<Function_Call>(ex)) {
+      // function references can only come from `call`
+      if (call->func()) return false;
+      add_unique(s.functions, Util::normalize_underscores(call->name()) + "[f]");
+      return analyse(call->arguments(), s);
+    }
+    if (Arguments_Ptr args = Cast<Arguments>(ex)) {
+      for (Argument_Obj arg : args->elements()) {
+        if (!analyse(arg->value(), s)) return false;
+      }
+      return true;
+    }
+    if (Argument_Ptr arg = Cast<Argument>(ex)) {
+      return analyse(arg->value(), s);
+    }
+    if (Binary_Expression_Ptr bin = Cast<Binary_Expression>(ex)) {
+      return analyse(bin->left(), s) && analyse(bin->right(), s);
+    }
+    if (Unary_Expression_Ptr un = Cast<Unary_Expression>(ex)) {
+      return analyse(un->operand(), s);
+    }
+    if (List_Ptr list = Cast<List>(ex)) {
+      for (Expression_Obj item : list->elements()) {
+        if (!analyse(item, s)) return false;
+      }
+      return true;
+    }
+    if (Map_Ptr map = Cast<Map>(ex)) {
+      for (Expression_Obj key : map->keys()) {
+        if (!analyse(key, s)) return false;
+        if (!analyse(map->at(key), s)) return false;
+      }
+      return true;
+    }
+    if (String_Schema_Ptr schema = Cast<String_Schema>(ex)) {
+      for (Expression_Obj item : schema->elements()) {
+        if (!analyse(item, s)) return false;
+      }
+      return true;
+    }
+    if (Cast<Number>(ex)) return true;
+    if (Cast<Color>(ex)) return true;
+    if (Cast<Boolean>(ex)) return true;
+    if (Cast<Null>(ex)) return true;
+    if (Cast<String_Quoted>(ex)) return true;
+    if (Cast<String_Constant>(ex)) return true;
+    // selectors (i.e. `&`), dynamic calls etc.
+    return false;
+  }
+
+  // walk the statements of a function body
+  static bool analyse(Block_Ptr b, Purity::Summary& s, Parameters_Ptr params)
+  {
+    if (!b) return true;
+    for (Statement_Obj stm : b->elements()) {
+      if (Assignment_Ptr a = Cast<Assignment>(stm)) {
+        // may write to the global scope
+        if (a->is_global() || a->is_default()) return false;
+        bool is_param = false;
+        for (Parameter_Obj p : params->elements()) {
+          if (p->name() == a->variable()) is_param = true;
+        }
+        if (!is_param) s.writes = true;
+        if (!analyse(a->value(), s)) return false;
+      }
+      else if (Return_Ptr r = Cast<Return>(stm)) {
+        if (!analyse(r->value(), s)) return false;
+      }
+      else if (If_Ptr i = Cast<If>(stm)) {
+        if (!analyse(i->predicate(), s)) return false;
+        if (!analyse(i->block(), s, params)) return false;
+        if (!analyse(i->alternative(), s, params)) return false;
+      }
+      else if (For_Ptr f = Cast<For>(stm)) {
+        if (!analyse(f->lower_bound(), s)) return false;
+        if (!analyse(f->upper_bound(), s)) return false;
+        if (!analyse(f->block(), s, params)) return false;
+      }
+      else if (Each_Ptr e = Cast<Each>(stm)) {
+        if (!analyse(e->list(), s)) return false;
+        if (!analyse(e->block(), s, params)) return false;
+      }
+      else if (While_Ptr w = Cast<While>(stm)) {
+        if (!analyse(w->predicate(), s)) return false;
+        if (!analyse(w->block(), s, params)) return false;
+      }
+      // aborts the compilation, no result is cached
+      else if (Error_Ptr err = Cast<Error>(stm)) {
+        if (!analyse(err->message(), s)) return false;
+      }
+      else if (Comment_Ptr comment = Cast<Comment>(stm)) {
+        if (!analyse(comment->text(), s)) return false;
+      }
+      // the body of a mixin may also emit declarations
+      else if (Declaration_Ptr d = Cast<Declaration>(stm)) {
+        if (!analyse(d->property(), s)) return false;
+        if (!analyse(d->value(), s)) return false;
+        if (!analyse(d->block(), s, params)) return false;
+      }
+      // and include other mixins, as long as they take no content
+      else if (Mixin_Call_Ptr call = Cast<Mixin_Call>(stm)) {
+        if (call->block()) return false;
+        add_unique(s.functions, call->name() + "[m]");
+        if (!analyse(call->arguments(), s)) return false;
+      }
+      // nested rules depend on the selector of the include
+      else if (Ruleset_Ptr r = Cast<Ruleset>(stm)) {
+        Selector_List_Ptr sel = r->selector();
+        if (sel && sel->schema() && !analyse(sel->schema()->contents(), s)) return false;
+        if (!analyse(r->block(), s, params)) return false;
+        s.rules = true;
+      }
+      // emits nothing unless the include passes a block
+      else if (Cast<Content>(stm)) {
+        s.content = true;
+      }
+      // @debug, @warn, @media and anything unexpected
+      else {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  Purity::Summary::Summary()
+  : pure(true), writes(false), mixin(false), rules(false), content(false),
+    variables(), functions(), verdict(-1)
+  { }
+
+  Purity::Purity()
+  : summaries_()
+  { }
+
+  Purity::Summary& Purity::summary(Definition_Ptr def)
+  {
+    Block_Ptr body = def->block();
+    auto it = summaries_.find(body);
+    if (it != summaries_.end()) return it->second;
+    Summary& s = summaries_[body];
+    s.mixin = def->type() == Definition::MIXIN;
+    Parameters_Ptr params = def->parameters();
+    for (Parameter_Obj p : params->elements()) {
+      s.pure = s.pure && analyse(p->default_value(), s);
+    }
+    s.pure = s.pure && analyse(body, s, params);
+    // parameters are always bound in the local frame
+    for (Parameter_Obj p : params->elements()) {
+      auto pos = std::find(s.variables.begin(), s.variables.end(), p->name());
+      if (pos != s.variables.end()) s.variables.erase(pos);
+    }
+    return s;
+  }
+
+  bool Purity::collect(Definition_Ptr def, Call_Cache::Key& key, std::set<Definition_Ptr>& visited)
+  {
+    // recursion is fine, the first visit decides
+    if (!visited.insert(def).second) return true;
+    // custom functions can do anything
+    if (def->c_function()) return false;
+    // only flagged built-ins are pure (`if` only evaluates its arguments)
+    if (!def->block()) return def->is_pure() || def->name() == "if";
+    Summary& s = summary(def);
+    if (!s.pure) return false;
+    Env* env = def->environment();
+    // assignments may update variables in an enclosing mixin or rule
+    if (s.writes && env->is_lexical()) return false;
+    // the content block of an enclosing include
+    if (s.content && env->has("@content[m]")) return false;
+    if (s.rules) key.selector = true;
+    for (const std::string& name : s.variables) {
+      EnvResult rv(env->find(name));
+      Expression_Ptr value = 0;
+      if (rv.found) value = Cast<Expression>(rv.it->second.ptr());
+      if (Argument_Ptr arg = Cast<Argument>(value)) value = arg->value();
+      if (rv.found && !value) return false;
+      key.depend(value);
+    }
+    for (const std::string& name : s.functions) {
+      std::string full_name(name);
+      // plain css function unless we have a generic handler
+      // (mixins must exist, otherwise the expansion fails)
+      if (!env->has(name) && name.compare(name.size() - 3, 3, "[f]") == 0) full_name = "*[f]";
+      Definition_Ptr callee = 0;
+      if (env->has(full_name)) callee = Cast<Definition>((*env)[full_name]);
+      key.depend(callee);
+      if (callee && !collect(callee, key, visited)) return false;
+    }
+    return true;
+  }
+
+  bool Purity::dependencies(Definition_Ptr def, Call_Cache::Key& key)
+  {
+    std::set<Definition_Ptr> visited;
+    bool pure = collect(def, key, visited);
+    if (def->block()) summary(def).verdict = pure;
+    return pure;
+  }
+
+  size_t Purity::pure_functions() const
+  {
+    size_t count = 0;
+    for (const auto& it : summaries_) count += !it.second.mixin && it.second.verdict == 1;
+    return count;
+  }
+
+  size_t Purity::impure_functions() const
+  {
+    size_t count = 0;
+    for (const auto& it : summaries_) count += !it.second.mixin && it.second.verdict == 0;
+    return count;
+  }
+
+}
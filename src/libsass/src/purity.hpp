@@ -0,0 +1,72 @@
+#ifndef SASS_PURITY_H
+#define SASS_PURITY_H
+
+#include <set>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "ast_fwd_decl.hpp"
+#include "call_cache.hpp"
+
+namespace Sass {
+
+  // Static analysis of user-defined functions and mixins. A body is
+  // free of side effects if it has no `!global` or `!default`
+  // assignment and no `@debug` or `@warn` directives. Mixins must
+  // further only emit declarations, nested rules (which depend on
+  // the selector of the include) and `@content` (which emits nothing
+  // for includes without a block). Whether a call is pure
+  // additionally depends on the functions and mixins it calls and
+  // the free variables it reads, which are resolved on every call.
+  class Purity {
+
+  public:
+
+    struct Summary {
+      Summary();
+      // body is free of side effects
+      bool pure;
+      // body assigns to variables other than its parameters
+      bool writes;
+      // definition is a mixin
+      bool mixin;
+      // body emits nested rules
+      bool rules;
+      // body uses @content
+      bool content;
+      // free variables read by the body
+      std::vector<std::string> variables;
+      // functions and mixins called by name (full env key)
+      std::vector<std::string> functions;
+      // outcome of the last full check (-1 for unknown)
+      int verdict;
+    };
+
+  private:
+
+    // summaries are shared by all copies of a definition
+    std::unordered_map<Block_Ptr, Summary> summaries_;
+
+    Summary& summary(Definition_Ptr def);
+    bool collect(Definition_Ptr def, Call_Cache::Key& key, std::set<Definition_Ptr>& visited);
+
+  public:
+
+    Purity();
+
+    // add everything the result of calling def depends on
+    // besides its arguments to the key; false if impure
+    bool dependencies(Definition_Ptr def, Call_Cache::Key& key);
+
+    // number of analysed functions (not mixins) by their last verdict
+    size_t pure_functions() const;
+    size_t impure_functions() const;
+
+    void clear() { summaries_.clear(); }
+
+  };
+
+}
+
+#endif
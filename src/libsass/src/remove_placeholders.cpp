@@ -32,6 +32,20 @@ namespace Sass {
 
 
     void Remove_Placeholders::operator()(Ruleset_Ptr r) {
+        remove_placeholders(r);
+
+        // Iterate into child blocks
+        Block_Obj b = r->block();
+
+        for (size_t i = 0, L = b->length(); i < L; ++i) {
+            if (b->at(i)) {
+                Statement_Obj st = b->at(i);
+                st->perform(this);
+            }
+        }
+    }
+
+    void Remove_Placeholders::remove_placeholders(Ruleset_Ptr r) {
         // Create a new selector group without placeholders
         Selector_List_Obj sl = Cast<Selector_List>(r->selector());
 
@@ -58,16 +72,6 @@ namespace Sass {
             }
           }
         }
-
-        // Iterate into child blocks
-        Block_Obj b = r->block();
-
-        for (size_t i = 0, L = b->length(); i < L; ++i) {
-            if (b->at(i)) {
-                Statement_Obj st = b->at(i);
-                st->perform(this);
-            }
-        }
     }
 
     void Remove_Placeholders::operator()(Media_Block_Ptr m) {
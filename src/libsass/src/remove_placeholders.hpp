@@ -15,6 +15,8 @@ namespace Sass {
 
     public:
       Selector_List_Ptr remove_placeholders(Selector_List_Ptr);
+      // only cleans the selector, not the child rules
+      void remove_placeholders(Ruleset_Ptr);
 
     public:
         Remove_Placeholders();
@@ -54,6 +54,47 @@ extern "C" {
     if (ptr) free (ptr);
   }
 
+  // Count objects per node type from now on
+  void ADDCALL sass_heap_set_tracking(bool enabled)
+  {
+    Heap_Type::tracking.store(enabled, std::memory_order_relaxed);
+  }
+
+  bool ADDCALL sass_heap_get_tracking(void)
+  {
+    return Heap_Type::tracking.load(std::memory_order_relaxed);
+  }
+
+  // Report objects per node type
+  size_t ADDCALL sass_heap_type_count(void)
+  {
+    return Heap_Type::count();
+  }
+
+  const char* ADDCALL sass_heap_type_name(size_t i)
+  {
+    Heap_Type* type = Heap_Type::get(i);
+    return type ? type->name : 0;
+  }
+
+  size_t ADDCALL sass_heap_type_size(size_t i)
+  {
+    Heap_Type* type = Heap_Type::get(i);
+    return type ? type->size : 0;
+  }
+
+  size_t ADDCALL sass_heap_type_live(size_t i)
+  {
+    Heap_Type* type = Heap_Type::get(i);
+    return type ? type->live() : 0;
+  }
+
+  size_t ADDCALL sass_heap_type_total(size_t i)
+  {
+    Heap_Type* type = Heap_Type::get(i);
+    return type ? type->total() : 0;
+  }
+
   // caller must free the returned memory
   char* ADDCALL sass_string_quote (const char *str, const char quote_mark)
   {
@@ -2,6 +2,10 @@
 #include <cstring>
 #include <stdexcept>
 #include <sstream>
+#include <set>
+#include <atomic>
+#include <new>
+#include <thread>
 #include <string>
 #include <vector>
 
@@ -119,6 +123,39 @@ namespace Sass {
       c_ctx->source_map_string = 0;
       json_delete(json_err);
     }
+    catch (Exception::Cancelled& e) {
+      std::stringstream msg_stream;
+      JsonNode* json_err = json_mkobject();
+      msg_stream << e.errtype() << ": " << e.what() << std::endl;
+      json_append_member(json_err, "status", json_mknumber(6));
+      json_append_member(json_err, "message", json_mkstring(e.what()));
+      json_append_member(json_err, "formatted", json_mkstream(msg_stream));
+      try { c_ctx->error_json = json_stringify(json_err, "  "); }
+      catch (...) {}
+      c_ctx->error_message = sass_copy_string(msg_stream.str());
+      c_ctx->error_text = sass_copy_c_string(e.what());
+      c_ctx->error_status = 6;
+      c_ctx->output_string = 0;
+      c_ctx->source_map_string = 0;
+      json_delete(json_err);
+    }
+    catch (Exception::LimitExceeded& e) {
+      std::stringstream msg_stream;
+      JsonNode* json_err = json_mkobject();
+      msg_stream << e.errtype() << ": " << e.what() << std::endl;
+      json_append_member(json_err, "status", json_mknumber(7));
+      json_append_member(json_err, "limit", json_mkstring(e.limit.c_str()));
+      json_append_member(json_err, "message", json_mkstring(e.what()));
+      json_append_member(json_err, "formatted", json_mkstream(msg_stream));
+      try { c_ctx->error_json = json_stringify(json_err, "  "); }
+      catch (...) {}
+      c_ctx->error_message = sass_copy_string(msg_stream.str());
+      c_ctx->error_text = sass_copy_c_string(e.what());
+      c_ctx->error_status = 7;
+      c_ctx->output_string = 0;
+      c_ctx->source_map_string = 0;
+      json_delete(json_err);
+    }
     catch (std::bad_alloc& ba) {
       std::stringstream msg_stream;
       JsonNode* json_err = json_mkobject();
@@ -208,6 +245,33 @@ namespace Sass {
     catch (...) { return handle_error(c_ctx); }
   }
 
+  // copy the compile stats on to the context
+  static void copy_stats(Sass_Context* c_ctx, Context* cpp_ctx)
+  {
+    const Compile_Stats& stats = cpp_ctx->stats;
+    c_ctx->parse_time = stats.parse;
+    c_ctx->expand_time = stats.expand;
+    c_ctx->check_nesting_time = stats.check_nesting;
+    c_ctx->cssize_time = stats.cssize;
+    c_ctx->extend_time = stats.extend;
+    c_ctx->remove_placeholders_time = stats.remove_placeholders;
+    c_ctx->output_time = stats.output;
+    c_ctx->function_calls = stats.function_calls;
+    c_ctx->mixin_includes = stats.mixin_includes;
+    c_ctx->extend_lookups = cpp_ctx->subset_map.lookups;
+    c_ctx->allocated_nodes = stats.allocated_nodes;
+    c_ctx->output_bytes = stats.output_bytes;
+    c_ctx->c_function_calls = stats.c_function_calls;
+    c_ctx->c_function_cache_hits = stats.c_function_cache_hits;
+    // report how often the function cache was used
+    c_ctx->call_cache_hits = cpp_ctx->call_cache.hits;
+    c_ctx->call_cache_misses = cpp_ctx->call_cache.misses;
+    c_ctx->pure_functions = cpp_ctx->purity.pure_functions();
+    c_ctx->impure_functions = cpp_ctx->purity.impure_functions();
+    c_ctx->mixin_cache_hits = cpp_ctx->mixin_cache.hits;
+    c_ctx->mixin_cache_misses = cpp_ctx->mixin_cache.misses;
+  }
+
   static Block_Obj sass_parse_block(Sass_Compiler* compiler) throw()
   {
 
@@ -231,7 +295,10 @@ namespace Sass {
       bool skip = c_ctx->type == SASS_CONTEXT_DATA;
 
       // dispatch parse call
+      cpp_ctx->allocated_base = SharedObj::getAllocated();
+      cpp_ctx->compile_thread = std::this_thread::get_id();
       Block_Obj root(cpp_ctx->parse());
+      cpp_ctx->stats.allocated_nodes += SharedObj::getAllocated() - cpp_ctx->allocated_base;
       // abort on errors
       if (!root) return 0;
 
@@ -245,6 +312,38 @@ namespace Sass {
       if (copy_strings(cpp_ctx->get_included_files(skip, headers), &c_ctx->included_files) == NULL)
         throw(std::bad_alloc());
 
+      // copy the parse time of every file on to the context
+      std::vector<std::string> parsed_files;
+      for (auto file : cpp_ctx->stats.files) parsed_files.push_back(file.first);
+      if (copy_strings(parsed_files, &c_ctx->parsed_files) == NULL)
+        throw(std::bad_alloc());
+      c_ctx->parse_times = (double*) calloc(parsed_files.size() + 1, sizeof(double));
+      if (c_ctx->parse_times == NULL) throw(std::bad_alloc());
+      for (size_t i = 0, S = parsed_files.size(); i < S; ++i) {
+        c_ctx->parse_times[i] = cpp_ctx->stats.files[i].second;
+      }
+
+      // copy the import graph without duplicate edges
+      std::vector<std::string> import_parents, import_files;
+      std::set<std::pair<std::string, std::string>> edges;
+      for (auto edge : cpp_ctx->import_graph) {
+        if (!edges.insert(edge).second) continue;
+        import_parents.push_back(edge.first);
+        import_files.push_back(edge.second);
+      }
+      if (copy_strings(import_parents, &c_ctx->import_parents) == NULL)
+        throw(std::bad_alloc());
+      if (copy_strings(import_files, &c_ctx->import_files) == NULL)
+        throw(std::bad_alloc());
+
+      // report timings and counters
+      copy_stats(c_ctx, cpp_ctx);
+
+      // all functions and mixins are evaluated by now
+      if (cpp_ctx->profiler) {
+        c_ctx->profile_string = sass_copy_string(cpp_ctx->profiler->render());
+      }
+
       // return parsed block
       return root;
 
@@ -270,7 +369,7 @@ extern "C" {
     // free assigned memory
     sass_clear_options(to);
     // move memory
-    *to = *from;
+    memcpy(static_cast<void*>(to), from, sizeof(struct Sass_Options));
     // Reset pointers on source
     sass_reset_options(from);
   }
@@ -401,6 +500,7 @@ extern "C" {
     if (ctx == 0) { std::cerr << "Error allocating memory for file context" << std::endl; return 0; }
     ctx->type = SASS_CONTEXT_FILE;
     init_options(ctx);
+    ctx->cancelled = new (std::nothrow) std::atomic<bool>(false);
     try {
       if (input_path == 0) { throw(std::runtime_error("File context created without an input path")); }
       if (*input_path == 0) { throw(std::runtime_error("File context created with empty input path")); }
@@ -417,6 +517,7 @@ extern "C" {
     if (ctx == 0) { std::cerr << "Error allocating memory for data context" << std::endl; return 0; }
     ctx->type = SASS_CONTEXT_DATA;
     init_options(ctx);
+    ctx->cancelled = new (std::nothrow) std::atomic<bool>(false);
     try {
       if (source_string == 0) { throw(std::runtime_error("Data context created without a source string")); }
       if (*source_string == 0) { throw(std::runtime_error("Data context created with empty source string")); }
@@ -427,6 +528,17 @@ extern "C" {
     return ctx;
   }
 
+  Sass_Variant_Context* ADDCALL sass_make_variant_context(const char* prelude)
+  {
+    struct Sass_Variant_Context* ctx = (struct Sass_Variant_Context*) calloc(1, sizeof(struct Sass_Variant_Context));
+    if (ctx == 0) { std::cerr << "Error allocating memory for variant context" << std::endl; return 0; }
+    ctx->type = SASS_CONTEXT_DATA;
+    init_options(ctx);
+    ctx->cancelled = new (std::nothrow) std::atomic<bool>(false);
+    ctx->prelude = prelude ? sass_copy_c_string(prelude) : 0;
+    return ctx;
+  }
+
   struct Sass_Compiler* ADDCALL sass_make_data_compiler (struct Sass_Data_Context* data_ctx)
   {
     if (data_ctx == 0) return 0;
@@ -470,6 +582,114 @@ extern "C" {
     return sass_compile_context(file_ctx, cpp_ctx);
   }
 
+  // generic parse function (not exported, use file/data parse instead)
+  static int sass_parse_context (Sass_Context* c_ctx, Context* cpp_ctx)
+  {
+
+    // stop once all imports are resolved
+    cpp_ctx->parse_only = true;
+    // prepare sass compiler with context and options
+    Sass_Compiler* compiler = sass_prepare_context(c_ctx, cpp_ctx);
+
+    try { sass_compiler_parse(compiler); }
+    // pass errors to generic error handler
+    catch (...) { handle_errors(c_ctx); }
+
+    sass_delete_compiler(compiler);
+
+    return c_ctx->error_status;
+  }
+
+  int ADDCALL sass_parse_data_context(Sass_Data_Context* data_ctx)
+  {
+    if (data_ctx == 0) return 1;
+    if (data_ctx->error_status)
+      return data_ctx->error_status;
+    try {
+      if (data_ctx->source_string == 0) { throw(std::runtime_error("Data context has no source string")); }
+    }
+    catch (...) { return handle_errors(data_ctx) | 1; }
+    Context* cpp_ctx = new Data_Context(*data_ctx);
+    return sass_parse_context(data_ctx, cpp_ctx);
+  }
+
+  int ADDCALL sass_parse_file_context(Sass_File_Context* file_ctx)
+  {
+    if (file_ctx == 0) return 1;
+    if (file_ctx->error_status)
+      return file_ctx->error_status;
+    try {
+      if (file_ctx->input_path == 0) { throw(std::runtime_error("File context has no input path")); }
+      if (*file_ctx->input_path == 0) { throw(std::runtime_error("File context has empty input path")); }
+    }
+    catch (...) { return handle_errors(file_ctx) | 1; }
+    Context* cpp_ctx = new File_Context(*file_ctx);
+    return sass_parse_context(file_ctx, cpp_ctx);
+  }
+
+  // generic variant function (not exported, use file/data variants instead)
+  static int sass_compile_variants (Sass_Context* c_ctx, Context* cpp_ctx, Sass_Variant_Context** variants, size_t count)
+  {
+
+    // parse and check the sheets once for all variants
+    cpp_ctx->parse_only = true;
+    cpp_ctx->shared_parse = true;
+    // prepare sass compiler with context and options
+    Sass_Compiler* compiler = sass_prepare_context(c_ctx, cpp_ctx);
+
+    try { sass_compiler_parse(compiler); }
+    // pass errors to generic error handler
+    catch (...) { handle_errors(c_ctx); }
+
+    // the variants share the parsed sheets, which are still altered
+    // by the evaluation (i.e. delayed flags), so they are compiled
+    // one after the other
+    for (size_t i = 0; c_ctx->error_status == 0 && i < count; ++i) {
+      Sass_Variant_Context* variant = variants[i];
+      if (variant == 0 || variant->error_status) continue;
+      // paths are relative to the entry unless set
+      variant->type = c_ctx->type;
+      if (variant->input_path == 0) sass_option_set_input_path(variant, c_ctx->input_path);
+      if (c_ctx->cancelled && c_ctx->cancelled->load()) sass_context_cancel(variant);
+      sass_compile_context(variant, new Variant_Context(*variant, *cpp_ctx));
+    }
+
+    sass_delete_compiler(compiler);
+
+    if (c_ctx->error_status) return c_ctx->error_status;
+    for (size_t i = 0; i < count; ++i) {
+      if (variants[i] && variants[i]->error_status) return variants[i]->error_status;
+    }
+    return 0;
+  }
+
+  int ADDCALL sass_compile_file_variants(Sass_File_Context* file_ctx, Sass_Variant_Context** variants, size_t count)
+  {
+    if (file_ctx == 0) return 1;
+    if (file_ctx->error_status)
+      return file_ctx->error_status;
+    try {
+      if (file_ctx->input_path == 0) { throw(std::runtime_error("File context has no input path")); }
+      if (*file_ctx->input_path == 0) { throw(std::runtime_error("File context has empty input path")); }
+    }
+    catch (...) { return handle_errors(file_ctx) | 1; }
+    Context* cpp_ctx = new File_Context(*file_ctx);
+    return sass_compile_variants(file_ctx, cpp_ctx, variants, count);
+  }
+
+  int ADDCALL sass_compile_data_variants(Sass_Data_Context* data_ctx, Sass_Variant_Context** variants, size_t count)
+  {
+    if (data_ctx == 0) return 1;
+    if (data_ctx->error_status)
+      return data_ctx->error_status;
+    try {
+      if (data_ctx->source_string == 0) { throw(std::runtime_error("Data context has no source string")); }
+    }
+    catch (...) { return handle_errors(data_ctx) | 1; }
+    Context* cpp_ctx = new Data_Context(*data_ctx);
+    return sass_compile_variants(data_ctx, cpp_ctx, variants, count);
+  }
+
   int ADDCALL sass_compiler_parse(struct Sass_Compiler* compiler)
   {
     if (compiler == 0) return 1;
@@ -499,9 +719,14 @@ extern "C" {
     Context* cpp_ctx = compiler->cpp_ctx;
     Block_Obj root = compiler->root;
     // compile the parsed root block
+    cpp_ctx->allocated_base = SharedObj::getAllocated();
+    cpp_ctx->compile_thread = std::this_thread::get_id();
     try { compiler->c_ctx->output_string = cpp_ctx->render(root); }
     // pass catched errors to generic error handler
     catch (...) { return handle_errors(compiler->c_ctx) | 1; }
+    cpp_ctx->stats.allocated_nodes += SharedObj::getAllocated() - cpp_ctx->allocated_base;
+    // update stats with the output phase
+    copy_stats(compiler->c_ctx, cpp_ctx);
     // generate source map json and store on context
     compiler->c_ctx->source_map_string = cpp_ctx->render_srcmap();
     // success
@@ -587,23 +812,36 @@ extern "C" {
     // release the allocated memory (mostly via sass_copy_c_string)
     if (ctx->output_string)     free(ctx->output_string);
     if (ctx->source_map_string) free(ctx->source_map_string);
+    if (ctx->profile_string)    free(ctx->profile_string);
     if (ctx->error_message)     free(ctx->error_message);
     if (ctx->error_text)        free(ctx->error_text);
     if (ctx->error_json)        free(ctx->error_json);
     if (ctx->error_file)        free(ctx->error_file);
     free_string_array(ctx->included_files);
+    free_string_array(ctx->parsed_files);
+    if (ctx->parse_times)       free(ctx->parse_times);
+    free_string_array(ctx->import_parents);
+    free_string_array(ctx->import_files);
     // play safe and reset properties
     ctx->output_string = 0;
     ctx->source_map_string = 0;
+    ctx->profile_string = 0;
     ctx->error_message = 0;
     ctx->error_text = 0;
     ctx->error_json = 0;
     ctx->error_file = 0;
     ctx->included_files = 0;
+    ctx->parsed_files = 0;
+    ctx->parse_times = 0;
+    ctx->import_parents = 0;
+    ctx->import_files = 0;
     // debug leaked memory
     #ifdef DEBUG_SHARED_PTR
       SharedObj::dumpMemLeaks();
     #endif
+    // the flag is owned by the context
+    delete ctx->cancelled;
+    ctx->cancelled = 0;
     // now clear the options
     sass_clear_options(ctx);
   }
@@ -642,14 +880,29 @@ extern "C" {
     sass_clear_context(ctx); free(ctx);
   }
 
+  // Deallocate all associated memory with variant context
+  void ADDCALL sass_delete_variant_context (struct Sass_Variant_Context* ctx)
+  {
+    free(ctx->prelude);
+    // clear the context and free it
+    sass_clear_context(ctx); free(ctx);
+  }
+
+  void ADDCALL sass_context_cancel (struct Sass_Context* ctx)
+  {
+    if (ctx->cancelled) ctx->cancelled->store(true);
+  }
+
   // Getters for sass context from specific implementations
   struct Sass_Context* ADDCALL sass_file_context_get_context(struct Sass_File_Context* ctx) { return ctx; }
   struct Sass_Context* ADDCALL sass_data_context_get_context(struct Sass_Data_Context* ctx) { return ctx; }
+  struct Sass_Context* ADDCALL sass_variant_context_get_context(struct Sass_Variant_Context* ctx) { return ctx; }
 
   // Getters for context options from Sass_Context
   struct Sass_Options* ADDCALL sass_context_get_options(struct Sass_Context* ctx) { return ctx; }
   struct Sass_Options* ADDCALL sass_file_context_get_options(struct Sass_File_Context* ctx) { return ctx; }
   struct Sass_Options* ADDCALL sass_data_context_get_options(struct Sass_Data_Context* ctx) { return ctx; }
+  struct Sass_Options* ADDCALL sass_variant_context_get_options(struct Sass_Variant_Context* ctx) { return ctx; }
   void ADDCALL sass_file_context_set_options (struct Sass_File_Context* ctx, struct Sass_Options* opt) { copy_options(ctx, opt); }
   void ADDCALL sass_data_context_set_options (struct Sass_Data_Context* ctx, struct Sass_Options* opt) { copy_options(ctx, opt); }
 
@@ -679,6 +932,15 @@ extern "C" {
   IMPLEMENT_SASS_OPTION_ACCESSOR(bool, source_map_file_urls);
   IMPLEMENT_SASS_OPTION_ACCESSOR(bool, omit_source_map_url);
   IMPLEMENT_SASS_OPTION_ACCESSOR(bool, is_indented_syntax_src);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(bool, memoize_functions);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(bool, memoize_mixins);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(enum Sass_Profile_Style, profile_style);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(int, parse_threads);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(int, extend_threads);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(int, output_threads);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(size_t, time_limit);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(size_t, node_limit);
+  IMPLEMENT_SASS_OPTION_ACCESSOR(size_t, output_limit);
   IMPLEMENT_SASS_OPTION_ACCESSOR(Sass_Function_List, c_functions);
   IMPLEMENT_SASS_OPTION_ACCESSOR(Sass_Importer_List, c_importers);
   IMPLEMENT_SASS_OPTION_ACCESSOR(Sass_Importer_List, c_headers);
@@ -702,7 +964,32 @@ extern "C" {
   IMPLEMENT_SASS_CONTEXT_GETTER(const char*, error_src);
   IMPLEMENT_SASS_CONTEXT_GETTER(const char*, output_string);
   IMPLEMENT_SASS_CONTEXT_GETTER(const char*, source_map_string);
+  IMPLEMENT_SASS_CONTEXT_GETTER(const char*, profile_string);
   IMPLEMENT_SASS_CONTEXT_GETTER(char**, included_files);
+  IMPLEMENT_SASS_CONTEXT_GETTER(size_t, call_cache_hits);
+  IMPLEMENT_SASS_CONTEXT_GETTER(size_t, call_cache_misses);
+  IMPLEMENT_SASS_CONTEXT_GETTER(size_t, pure_functions);
+  IMPLEMENT_SASS_CONTEXT_GETTER(size_t, impure_functions);
+  IMPLEMENT_SASS_CONTEXT_GETTER(size_t, mixin_cache_hits);
+  IMPLEMENT_SASS_CONTEXT_GETTER(size_t, mixin_cache_misses);
+  IMPLEMENT_SASS_CONTEXT_GETTER(double, parse_time);
+  IMPLEMENT_SASS_CONTEXT_GETTER(double, expand_time);
+  IMPLEMENT_SASS_CONTEXT_GETTER(double, check_nesting_time);
+  IMPLEMENT_SASS_CONTEXT_GETTER(double, cssize_time);
+  IMPLEMENT_SASS_CONTEXT_GETTER(double, extend_time);
+  IMPLEMENT_SASS_CONTEXT_GETTER(double, remove_placeholders_time);
+  IMPLEMENT_SASS_CONTEXT_GETTER(double, output_time);
+  IMPLEMENT_SASS_CONTEXT_GETTER(char**, parsed_files);
+  IMPLEMENT_SASS_CONTEXT_GETTER(double*, parse_times);
+  IMPLEMENT_SASS_CONTEXT_GETTER(char**, import_parents);
+  IMPLEMENT_SASS_CONTEXT_GETTER(char**, import_files);
+  IMPLEMENT_SASS_CONTEXT_GETTER(size_t, function_calls);
+  IMPLEMENT_SASS_CONTEXT_GETTER(size_t, c_function_calls);
+  IMPLEMENT_SASS_CONTEXT_GETTER(size_t, c_function_cache_hits);
+  IMPLEMENT_SASS_CONTEXT_GETTER(size_t, mixin_includes);
+  IMPLEMENT_SASS_CONTEXT_GETTER(size_t, extend_lookups);
+  IMPLEMENT_SASS_CONTEXT_GETTER(size_t, allocated_nodes);
+  IMPLEMENT_SASS_CONTEXT_GETTER(size_t, output_bytes);
 
   // Take ownership of memory (value on context is set to 0)
   IMPLEMENT_SASS_CONTEXT_TAKER(char*, error_json);
@@ -711,6 +998,7 @@ extern "C" {
   IMPLEMENT_SASS_CONTEXT_TAKER(char*, error_file);
   IMPLEMENT_SASS_CONTEXT_TAKER(char*, output_string);
   IMPLEMENT_SASS_CONTEXT_TAKER(char*, source_map_string);
+  IMPLEMENT_SASS_CONTEXT_TAKER(char*, profile_string);
   IMPLEMENT_SASS_CONTEXT_TAKER(char**, included_files);
 
   // Push function for include paths (no manipulation support for now)
@@ -1,6 +1,7 @@
 #ifndef SASS_SASS_CONTEXT_H
 #define SASS_SASS_CONTEXT_H
 
+#include <atomic>
 #include "sass/base.h"
 #include "sass/context.h"
 #include "ast_fwd_decl.hpp"
@@ -23,6 +24,33 @@ struct Sass_Options : Sass_Output_Options {
   // Treat source_string as sass (as opposed to scss)
   bool is_indented_syntax_src;
 
+  // Memoize calls to pure functions
+  bool memoize_functions;
+
+  // Memoize expanded bodies of pure mixins
+  bool memoize_mixins;
+
+  // Profile functions and mixins
+  enum Sass_Profile_Style profile_style;
+
+  // Parse imported files on this many threads
+  int parse_threads;
+
+  // Apply the @extends on this many threads
+  int extend_threads;
+
+  // Render the output on this many threads
+  int output_threads;
+
+  // Fail once the compilation took this many milliseconds
+  size_t time_limit;
+
+  // Fail once this many nodes were allocated
+  size_t node_limit;
+
+  // Fail once the output grew over this many bytes
+  size_t output_limit;
+
   // The input path is used for source map
   // generation. It can be used to define
   // something with string compilation or to
@@ -75,12 +103,19 @@ struct Sass_Context : Sass_Options
   // store context type info
   enum Sass_Input_Style type;
 
+  // Set from another thread to stop the compilation
+  // (allocated separately, the options are plain memory)
+  std::atomic<bool>* cancelled;
+
   // generated output data
   char* output_string;
 
   // generated source map json
   char* source_map_string;
 
+  // generated profile report
+  char* profile_string;
+
   // error status
   int error_status;
   char* error_json;
@@ -95,6 +130,43 @@ struct Sass_Context : Sass_Options
   // report imported files
   char** included_files;
 
+  // report function cache usage
+  size_t call_cache_hits;
+  size_t call_cache_misses;
+  // report purity analysis of user functions
+  size_t pure_functions;
+  size_t impure_functions;
+
+  // report mixin cache usage
+  size_t mixin_cache_hits;
+  size_t mixin_cache_misses;
+
+  // report time spent per phase (in milliseconds)
+  double parse_time;
+  double expand_time;
+  double check_nesting_time;
+  double cssize_time;
+  double extend_time;
+  double remove_placeholders_time;
+  double output_time;
+
+  // report parse time per file (same order)
+  char** parsed_files;
+  double* parse_times;
+
+  // report direct imports (same order)
+  char** import_parents;
+  char** import_files;
+
+  // report compile counters
+  size_t function_calls;
+  size_t mixin_includes;
+  size_t extend_lookups;
+  size_t allocated_nodes;
+  size_t output_bytes;
+  size_t c_function_calls;
+  size_t c_function_cache_hits;
+
 };
 
 // struct for file compilation
@@ -114,6 +186,14 @@ struct Sass_Data_Context : Sass_Context {
 
 };
 
+// struct for variant compilation
+struct Sass_Variant_Context : Sass_Context {
+
+  // evaluated before the entry
+  char* prelude;
+
+};
+
 // link c and cpp context
 struct Sass_Compiler {
   // progress status
@@ -24,6 +24,16 @@ extern "C" {
     return cb;
   }
 
+  Sass_Function_Entry ADDCALL sass_make_function_take_args(const char* signature, Sass_Function_Take_Fn function, void* cookie)
+  {
+    Sass_Function_Entry cb = (Sass_Function_Entry) calloc(1, sizeof(Sass_Function));
+    if (cb == 0) return 0;
+    cb->signature = sass_copy_c_string(signature);
+    cb->take_function = function;
+    cb->cookie = cookie;
+    return cb;
+  }
+
   void ADDCALL sass_delete_function(Sass_Function_Entry entry)
   {
     free(entry->signature);
@@ -48,7 +58,10 @@ extern "C" {
 
   const char* ADDCALL sass_function_get_signature(Sass_Function_Entry cb) { return cb->signature; }
   Sass_Function_Fn ADDCALL sass_function_get_function(Sass_Function_Entry cb) { return cb->function; }
+  Sass_Function_Take_Fn ADDCALL sass_function_get_take_function(Sass_Function_Entry cb) { return cb->take_function; }
   void* ADDCALL sass_function_get_cookie(Sass_Function_Entry cb) { return cb->cookie; }
+  bool ADDCALL sass_function_get_pure(Sass_Function_Entry cb) { return cb->pure; }
+  void ADDCALL sass_function_set_pure(Sass_Function_Entry cb, bool pure) { cb->pure = pure; }
 
   Sass_Importer_Entry ADDCALL sass_make_importer(Sass_Importer_Fn importer, double priority, void* cookie)
   {
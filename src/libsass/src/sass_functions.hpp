@@ -9,7 +9,9 @@
 struct Sass_Function {
   char*            signature;
   Sass_Function_Fn function;
+  Sass_Function_Take_Fn take_function;
   void*            cookie;
+  bool             pure;
 };
 
 // External import entry
@@ -88,12 +88,22 @@ namespace Sass {
     size_t previous_original_line = 0;
     size_t previous_original_column = 0;
     size_t previous_original_file = 0;
+    // mappings refer to the index of the resource, the map to the
+    // position in the sources (they differ after a parallel parse)
+    std::vector<size_t> source_pos;
+    for (size_t i = 0; i < source_index.size(); ++i) {
+      if (source_index[i] >= source_pos.size()) {
+        for (size_t n = source_pos.size(); n <= source_index[i]; ++n) source_pos.push_back(n);
+      }
+      source_pos[source_index[i]] = i;
+    }
     for (size_t i = 0; i < mappings.size(); ++i) {
       const size_t generated_line = mappings[i].generated_position.line;
       const size_t generated_column = mappings[i].generated_position.column;
       const size_t original_line = mappings[i].original_position.line;
       const size_t original_column = mappings[i].original_position.column;
-      const size_t original_file = mappings[i].original_position.file;
+      const size_t resource = mappings[i].original_position.file;
+      const size_t original_file = resource < source_pos.size() ? source_pos[resource] : resource;
 
       if (generated_line != previous_generated_line) {
         previous_generated_column = 0;
@@ -144,7 +154,17 @@ namespace Sass {
 
   void SourceMap::append(const OutputBuffer& out)
   {
-    append(Offset(out.buffer));
+    // move the new mappings behind the current position
+    mappings.reserve(mappings.size() + out.smap.mappings.size());
+    for (Mapping mapping : out.smap.mappings) {
+      if (mapping.generated_position.line == 0) {
+        mapping.generated_position.column += current_position.column;
+      }
+      mapping.generated_position.line += current_position.line;
+      mappings.push_back(mapping);
+    }
+    // the buffer may hold more than was accounted for
+    append(Offset(out.smap.current_position));
   }
 
   void SourceMap::prepend(const Offset& offset)
@@ -0,0 +1,50 @@
+#ifndef SASS_STATS_H
+#define SASS_STATS_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+
+namespace Sass {
+
+  // monotonic high resolution clock
+  typedef std::chrono::steady_clock Stats_Clock;
+
+  // milliseconds passed since start
+  inline double elapsed_ms(const Stats_Clock::time_point& start)
+  {
+    std::chrono::duration<double, std::milli> ms(Stats_Clock::now() - start);
+    return ms.count();
+  }
+
+  // Timings (in milliseconds) of the compile phases and
+  // counters of one compilation. Reported via the C-API.
+  struct Compile_Stats {
+    double parse;
+    double expand;
+    double check_nesting;
+    double cssize;
+    double extend;
+    double remove_placeholders;
+    double output;
+    // exclusive parse time per loaded file
+    std::vector<std::pair<std::string, double> > files;
+    size_t function_calls;
+    size_t mixin_includes;
+    size_t output_bytes;
+    size_t allocated_nodes;
+    // calls into c functions and calls served from the cache instead
+    size_t c_function_calls;
+    size_t c_function_cache_hits;
+
+    Compile_Stats()
+    : parse(0), expand(0), check_nesting(0), cssize(0), extend(0),
+      remove_placeholders(0), output(0), files(),
+      function_calls(0), mixin_includes(0), output_bytes(0),
+      allocated_nodes(0), c_function_calls(0), c_function_cache_hits(0)
+    { }
+  };
+
+}
+
+#endif
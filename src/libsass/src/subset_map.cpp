@@ -7,42 +7,74 @@ namespace Sass {
   void Subset_Map::put(const Compound_Selector_Obj& sel, const SubSetMapPair& value)
   {
     if (sel->empty()) throw std::runtime_error("internal error: subset map keys may not be empty");
-    size_t index = values_.size();
-    values_.push_back(value);
+    Key key;
+    key.mask = 0;
     for (size_t i = 0, S = sel->length(); i < S; ++i)
     {
-      hash_[(*sel)[i]].push_back(std::make_pair(sel, index));
+      size_t id = ids_.insert(std::make_pair((*sel)[i], ids_.size())).first->second;
+      key.ids.push_back(id);
+      key.mask |= uint64_t(1) << (id % 64);
+    }
+    std::sort(key.ids.begin(), key.ids.end());
+    key.ids.erase(std::unique(key.ids.begin(), key.ids.end()), key.ids.end());
+    if (index_.size() < ids_.size()) index_.resize(ids_.size());
+    // indexed by its rarest id so far, the fewest candidates to test
+    size_t rarest = key.ids.front();
+    for (size_t id : key.ids) {
+      if (index_[id].size() < index_[rarest].size()) rarest = id;
+    }
+    index_[rarest].push_back(values_.size());
+    values_.push_back(value);
+    keys_.push_back(key);
+  }
+
+  Subset_Map* Subset_Map::clone() const
+  {
+    Subset_Map* map = new Subset_Map();
+    // the pairs of an @extend share their target
+    std::map<Compound_Selector_Ptr, Compound_Selector_Obj> targets;
+    for (const SubSetMapPair& value : values_) {
+      Compound_Selector_Obj& target = targets[value.second];
+      if (!target) target = SASS_MEMORY_CLONE(value.second);
+      map->put(target, std::make_pair(SASS_MEMORY_CLONE(value.first), target));
     }
+    return map;
   }
 
   std::vector<SubSetMapPair> Subset_Map::get_kv(const Compound_Selector_Obj& sel)
   {
-    SimpleSelectorDict dict(sel->begin(), sel->end()); // XXX Set
-    std::vector<size_t> indices;
+    ++ lookups;
+    std::vector<SubSetMapPair> results;
+    if (values_.empty()) return results;
+    // the ids of the simple selectors that are part of any target
+    std::vector<size_t> ids;
+    uint64_t mask = 0;
     for (size_t i = 0, S = sel->length(); i < S; ++i) {
-      if (!hash_.count((*sel)[i])) {
-        continue;
-      }
-      const std::vector<std::pair<Compound_Selector_Obj, size_t> >& subsets = hash_[(*sel)[i]];
-      for (const std::pair<Compound_Selector_Obj, size_t>& item : subsets) {
-        bool include = true;
-        for (const Simple_Selector_Obj& it : item.first->elements()) {
-          auto found = dict.find(it);
-          if (found == dict.end()) {
-            include = false;
-            break;
-          }
+      auto id = ids_.find((*sel)[i]);
+      if (id == ids_.end()) continue;
+      ids.push_back(id->second);
+      mask |= uint64_t(1) << (id->second % 64);
+    }
+    if (ids.empty()) return results;
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+    std::vector<size_t> indices;
+    for (size_t id : ids) {
+      for (size_t index : index_[id]) {
+        const Key& key = keys_[index];
+        if (key.mask & ~mask) continue;
+        if (std::includes(ids.begin(), ids.end(), key.ids.begin(), key.ids.end())) {
+          indices.push_back(index);
         }
-        if (include) indices.push_back(item.second);
       }
     }
-    sort(indices.begin(), indices.end());
-    std::vector<size_t>::iterator indices_end = unique(indices.begin(), indices.end());
-    indices.resize(distance(indices.begin(), indices_end));
+    // in the order they were put
+    std::sort(indices.begin(), indices.end());
 
-    std::vector<SubSetMapPair> results;
-    for (size_t i = 0, S = indices.size(); i < S; ++i) {
-      results.push_back(values_[indices[i]]);
+    results.reserve(indices.size());
+    for (size_t index : indices) {
+      results.push_back(values_[index]);
     }
     return results;
   }
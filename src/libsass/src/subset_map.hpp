@@ -4,6 +4,8 @@
 #include <map>
 #include <set>
 #include <vector>
+#include <cstdint>
+#include <unordered_map>
 #include <algorithm>
 #include <iterator>
 
@@ -58,17 +60,36 @@
 
 namespace Sass {
 
+  // Maps compound selectors to the @extends whose targets are a subset
+  // of them. Simple selectors are interned to small ids, each target is
+  // a sorted array of ids with a bit mask of them (id modulo 64) that
+  // rules out most candidates before the arrays are compared. Targets
+  // are indexed by one of their ids only, so none is found twice.
   class Subset_Map {
   private:
+    struct Key {
+      std::vector<size_t> ids;
+      uint64_t mask;
+    };
     std::vector<SubSetMapPair> values_;
-    std::map<Simple_Selector_Obj, std::vector<std::pair<Compound_Selector_Obj, size_t> >, OrderNodes > hash_;
+    // the targets of the values, at the same positions
+    std::vector<Key> keys_;
+    std::unordered_map<Simple_Selector_Obj, size_t, HashNodes, CompareNodes> ids_;
+    // the values by one id of their target
+    std::vector<std::vector<size_t> > index_;
   public:
+    // number of lookups (for stats)
+    size_t lookups;
+    Subset_Map() : values_(), keys_(), ids_(), index_(), lookups(0) { }
     void put(const Compound_Selector_Obj& sel, const SubSetMapPair& value);
     std::vector<SubSetMapPair> get_kv(const Compound_Selector_Obj& s);
     std::vector<SubSetMapPair> get_v(const Compound_Selector_Obj& s);
     bool empty() { return values_.empty(); }
-    void clear() { values_.clear(); hash_.clear(); }
-    const std::vector<SubSetMapPair> values(void) { return values_; }
+    void clear() { values_.clear(); keys_.clear(); ids_.clear(); index_.clear(); }
+    const std::vector<SubSetMapPair>& values(void) const { return values_; }
+    // a copy with clones of all selectors, which can be
+    // read and flagged on another thread than this one
+    Subset_Map* clone() const;
   };
 
 }
@@ -0,0 +1,75 @@
+// Runs many compilations in parallel and checks that they all
+// produce the same output as a single compilation. Some of them
+// extend and render on several threads, sharing their nodes between
+// the workers (and static values with all compilations). Build with
+// ThreadSanitizer to check for data races on shared state:
+//
+// make -C libsass clean test_threads EXTRA_CXXFLAGS="-fsanitize=thread -g" EXTRA_LDFLAGS="-fsanitize=thread"
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <iostream>
+
+#include <sass.h>
+
+#define THREADS 64
+#define ROUNDS 10
+
+// touches random numbers, color names, caches and @extend
+static const char* source =
+  "$colors: (primary: royalblue, danger: crimson, muted: lightgray);\n"
+  "$seed: random();\n"
+  "$id: unique-id();\n"
+  "@function double($n) { @return $n * 2; }\n"
+  "@mixin button($color) { color: $color; border-color: darken($color, 10%); }\n"
+  "%base { margin: 0; }\n"
+  "@each $name, $color in $colors {\n"
+  "  .btn-#{$name} { @extend %base; @include button($color); width: double(5px);\n"
+  "    &:hover { background: mix($color, white, 20%); } }\n"
+  "}\n"
+  ".random { valid: if($seed >= 0 and $seed < 1, true, false); id: str-length($id) > 0; }\n"
+  ".named { color: red; background: transparent; }\n"
+  "@for $i from 1 through 40 { .row-#{$i} { @extend %base; width: double($i * 1px); } }\n";
+
+static std::string compile(bool memoize, bool parallel)
+{
+  struct Sass_Data_Context* data_ctx = sass_make_data_context(sass_copy_c_string(source));
+  struct Sass_Context* ctx = sass_data_context_get_context(data_ctx);
+  struct Sass_Options* options = sass_context_get_options(ctx);
+  sass_option_set_memoize_functions(options, memoize);
+  sass_option_set_memoize_mixins(options, memoize);
+  sass_option_set_extend_threads(options, parallel ? 4 : 0);
+  sass_option_set_output_threads(options, parallel ? 4 : 0);
+  std::string css;
+  if (sass_compile_data_context(data_ctx) == 0) {
+    css = sass_context_get_output_string(ctx);
+  }
+  else {
+    css = sass_context_get_error_message(ctx);
+  }
+  sass_delete_data_context(data_ctx);
+  return css;
+}
+
+int main()
+{
+  std::string expected(compile(false, false));
+  std::atomic<int> failures(0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < THREADS; ++i) {
+    threads.push_back(std::thread([i, &expected, &failures]() {
+      for (int round = 0; round < ROUNDS; ++round) {
+        if (compile((i + round) % 2 == 0, i % 4 == 0) != expected) ++ failures;
+      }
+    }));
+  }
+  for (std::thread& thread : threads) thread.join();
+  if (failures) {
+    std::cerr << failures << " of " << THREADS * ROUNDS << " compilations differ" << std::endl;
+    return 1;
+  }
+  std::cout << THREADS * ROUNDS << " compilations on " << THREADS << " threads" << std::endl;
+  return 0;
+}
@@ -6,11 +6,27 @@ extern "C" {
   void compile_it(uv_work_t* req) {
     sass_context_wrapper* ctx_w = (sass_context_wrapper*)req->data;
 
+    if (!ctx_w->variants.empty()) {
+      compile_variants(ctx_w);
+    }
+    else if (ctx_w->dctx) {
+      ctx_w->parse_only ? parse_data(ctx_w->dctx) : compile_data(ctx_w->dctx);
+    }
+    else if (ctx_w->fctx) {
+      ctx_w->parse_only ? parse_file(ctx_w->fctx) : compile_file(ctx_w->fctx);
+    }
+  }
+
+  // only sets a flag, the compile stops at its next checkpoint
+  void cancel_it(sass_context_wrapper* ctx_w) {
     if (ctx_w->dctx) {
-      compile_data(ctx_w->dctx);
+      sass_context_cancel(sass_data_context_get_context(ctx_w->dctx));
     }
     else if (ctx_w->fctx) {
-      compile_file(ctx_w->fctx);
+      sass_context_cancel(sass_file_context_get_context(ctx_w->fctx));
+    }
+    for (Sass_Variant_Context* variant : ctx_w->variants) {
+      sass_context_cancel(sass_variant_context_get_context(variant));
     }
   }
 
@@ -22,6 +38,23 @@ extern "C" {
     sass_compile_file_context(fctx);
   }
 
+  void parse_data(struct Sass_Data_Context* dctx) {
+    sass_parse_data_context(dctx);
+  }
+
+  void parse_file(struct Sass_File_Context* fctx) {
+    sass_parse_file_context(fctx);
+  }
+
+  void compile_variants(sass_context_wrapper* ctx_w) {
+    if (ctx_w->dctx) {
+      sass_compile_data_variants(ctx_w->dctx, ctx_w->variants.data(), ctx_w->variants.size());
+    }
+    else if (ctx_w->fctx) {
+      sass_compile_file_variants(ctx_w->fctx, ctx_w->variants.data(), ctx_w->variants.size());
+    }
+  }
+
   sass_context_wrapper* sass_make_context_wrapper() {
     return (sass_context_wrapper*)calloc(1, sizeof(sass_context_wrapper));
   }
@@ -41,8 +74,27 @@ extern "C" {
     delete ctx_w->success_callback;
 
     ctx_w->result.Reset();
+    ctx_w->variant_results.Reset();
+
+    // the handle may outlive the wrapper
+    if (!ctx_w->handle.IsEmpty()) {
+      Nan::HandleScope scope;
+      Nan::SetInternalFieldPointer(Nan::New(ctx_w->handle), 0, NULL);
+      ctx_w->handle.Reset();
+    }
+
+    for (Sass_Variant_Context* variant : ctx_w->variants) {
+      sass_delete_variant_context(variant);
+    }
+    for (char* str : ctx_w->variant_strings) {
+      free(str);
+    }
+    // the wrapper is freed without running its destructor
+    std::vector<Sass_Variant_Context*>().swap(ctx_w->variants);
+    std::vector<char*>().swap(ctx_w->variant_strings);
 
     free(ctx_w->include_path);
+    free(ctx_w->plugin_path);
     free(ctx_w->linefeed);
     free(ctx_w->out_file);
     free(ctx_w->source_map);
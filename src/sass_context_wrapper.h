@@ -15,14 +15,21 @@ extern "C" {
 
   void compile_data(struct Sass_Data_Context* dctx);
   void compile_file(struct Sass_File_Context* fctx);
+  void parse_data(struct Sass_Data_Context* dctx);
+  void parse_file(struct Sass_File_Context* fctx);
+  void compile_variants(struct sass_context_wrapper* ctx_w);
   void compile_it(uv_work_t* req);
+  void cancel_it(struct sass_context_wrapper* ctx_w);
 
   struct sass_context_wrapper {
     // binding related
     bool is_sync;
+    // only resolve the imports
+    bool parse_only;
     void* cookie;
     char* file;
     char* include_path;
+    char* plugin_path;
     char* out_file;
     char* source_map;
     char* source_map_root;
@@ -33,12 +40,19 @@ extern "C" {
     Sass_Data_Context* dctx;
     Sass_File_Context* fctx;
 
+    // compiled once for every variant
+    std::vector<Sass_Variant_Context*> variants;
+    std::vector<char*> variant_strings;
+
     // libuv related
     uv_async_t async;
     uv_work_t request;
 
     // v8 and nan related
     Nan::Persistent<v8::Object> result;
+    Nan::Persistent<v8::Array> variant_results;
+    // returned by an async render, to cancel it
+    Nan::Persistent<v8::Object> handle;
     Nan::AsyncResource* async_resource;
     Nan::Callback* error_callback;
     Nan::Callback* success_callback;
@@ -3,15 +3,16 @@
 
 namespace SassTypes
 {
-  Nan::Persistent<v8::Function> Boolean::constructor;
-  bool Boolean::constructor_locked = false;
+  thread_local Nan::Persistent<v8::Function> Boolean::constructor;
+  thread_local bool Boolean::constructor_locked = false;
 
   Boolean::Boolean(bool _value) {
     value = sass_make_boolean(_value);
+    root.reset(value, sass_delete_value);
   }
 
   Boolean& Boolean::get_singleton(bool v) {
-    static Boolean instance_false(false), instance_true(true);
+    static thread_local Boolean instance_false(false), instance_true(true);
     return v ? instance_true : instance_false;
   }
 
@@ -44,6 +45,13 @@ namespace SassTypes
     return scope.Escape(conslocal);
   }
 
+  void Boolean::cleanup() {
+    get_singleton(false).js_object.Reset();
+    get_singleton(true).js_object.Reset();
+    constructor.Reset();
+    constructor_locked = false;
+  }
+
   v8::Local<v8::Object> Boolean::get_js_object() {
     return Nan::New(this->js_object);
   }
@@ -11,6 +11,7 @@ namespace SassTypes
     public:
       static Boolean& get_singleton(bool);
       static v8::Local<v8::Function> get_constructor();
+      static void cleanup();
 
       v8::Local<v8::Object> get_js_object();
 
@@ -22,8 +23,8 @@ namespace SassTypes
 
       Nan::Persistent<v8::Object> js_object;
 
-      static Nan::Persistent<v8::Function> constructor;
-      static bool constructor_locked;
+      static thread_local Nan::Persistent<v8::Function> constructor;
+      static thread_local bool constructor_locked;
       v8::Local<v8::Boolean> get_js_boolean();
   };
 }
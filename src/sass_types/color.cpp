@@ -3,7 +3,7 @@
 
 namespace SassTypes
 {
-  Color::Color(Sass_Value* v) : SassValueWrapper(v) {}
+  Color::Color(Sass_Value* v, ValueRoot root) : SassValueWrapper(v, root) {}
 
   Sass_Value* Color::construct(const std::vector<v8::Local<v8::Value>> raw_val, Sass_Value **out) {
     double a = 1.0, r = 0, g = 0, b = 0;
@@ -86,7 +86,7 @@ namespace SassTypes
       return Nan::ThrowTypeError("Supplied value should be a number");
     }
 
-    sass_color_set_r(Color::Unwrap<Color>(info.This())->value, Nan::To<double>(info[0]).FromJust());
+    sass_color_set_r(Color::Unwrap<Color>(info.This())->mutable_value(), Nan::To<double>(info[0]).FromJust());
   }
 
   NAN_METHOD(Color::SetG) {
@@ -98,7 +98,7 @@ namespace SassTypes
       return Nan::ThrowTypeError("Supplied value should be a number");
     }
 
-    sass_color_set_g(Color::Unwrap<Color>(info.This())->value, Nan::To<double>(info[0]).FromJust());
+    sass_color_set_g(Color::Unwrap<Color>(info.This())->mutable_value(), Nan::To<double>(info[0]).FromJust());
   }
 
   NAN_METHOD(Color::SetB) {
@@ -110,7 +110,7 @@ namespace SassTypes
       return Nan::ThrowTypeError("Supplied value should be a number");
     }
 
-    sass_color_set_b(Color::Unwrap<Color>(info.This())->value, Nan::To<double>(info[0]).FromJust());
+    sass_color_set_b(Color::Unwrap<Color>(info.This())->mutable_value(), Nan::To<double>(info[0]).FromJust());
   }
 
   NAN_METHOD(Color::SetA) {
@@ -122,6 +122,6 @@ namespace SassTypes
       return Nan::ThrowTypeError("Supplied value should be a number");
     }
 
-    sass_color_set_a(Color::Unwrap<Color>(info.This())->value, Nan::To<double>(info[0]).FromJust());
+    sass_color_set_a(Color::Unwrap<Color>(info.This())->mutable_value(), Nan::To<double>(info[0]).FromJust());
   }
 }
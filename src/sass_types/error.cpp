@@ -4,7 +4,7 @@
 
 namespace SassTypes
 {
-  Error::Error(Sass_Value* v) : SassValueWrapper(v) {}
+  Error::Error(Sass_Value* v, ValueRoot root) : SassValueWrapper(v, root) {}
 
   Sass_Value* Error::construct(const std::vector<v8::Local<v8::Value>> raw_val, Sass_Value **out) {
     char const* value = "";
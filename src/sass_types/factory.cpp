@@ -12,31 +12,31 @@
 
 namespace SassTypes
 {
-  SassTypes::Value* Factory::create(Sass_Value* v) {
+  SassTypes::Value* Factory::create(Sass_Value* v, ValueRoot root) {
     switch (sass_value_get_tag(v)) {
     case SASS_NUMBER:
-      return new Number(v);
+      return new Number(v, root);
 
     case SASS_STRING:
-      return new String(v);
+      return new String(v, root);
 
     case SASS_COLOR:
-      return new Color(v);
+      return new Color(v, root);
 
     case SASS_BOOLEAN:
       return &Boolean::get_singleton(sass_boolean_get_value(v));
 
     case SASS_LIST:
-      return new List(v);
+      return new List(v, root);
 
     case SASS_MAP:
-      return new Map(v);
+      return new Map(v, root);
 
     case SASS_NULL:
       return &Null::get_singleton();
 
     case SASS_ERROR:
-      return new Error(v);
+      return new Error(v, root);
 
     default:
       const char *msg = "Unknown type encountered.";
@@ -60,6 +60,17 @@ namespace SassTypes
     Nan::Set(target, Nan::New<v8::String>("types").ToLocalChecked(), types);
   }
 
+  void Factory::cleanup() {
+    Number::cleanup();
+    String::cleanup();
+    Color::cleanup();
+    Boolean::cleanup();
+    List::cleanup();
+    Map::cleanup();
+    Null::cleanup();
+    Error::cleanup();
+  }
+
   Value* Factory::unwrap(v8::Local<v8::Value> obj) {
       if (obj->IsObject()) {
           v8::Local<v8::Object> v8_obj = obj.As<v8::Object>();
@@ -12,7 +12,10 @@ namespace SassTypes
   class Factory {
     public:
       static NAN_MODULE_INIT(initExports);
-      static Value* create(Sass_Value*);
+      // releases the constructors of the current isolate
+      static void cleanup();
+      // copies the value, or wraps it without copying if root owns it
+      static Value* create(Sass_Value*, ValueRoot = ValueRoot());
       static Value* unwrap(v8::Local<v8::Value>);
   };
 }
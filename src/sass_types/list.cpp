@@ -3,7 +3,7 @@
 
 namespace SassTypes
 {
-  List::List(Sass_Value* v) : SassValueWrapper(v) {}
+  List::List(Sass_Value* v, ValueRoot root) : SassValueWrapper(v, root) {}
 
   Sass_Value* List::construct(const std::vector<v8::Local<v8::Value>> raw_val, Sass_Value **out) {
     size_t length = 0;
@@ -47,7 +47,8 @@ namespace SassTypes
       return Nan::ThrowTypeError("Supplied index should be an integer");
     }
 
-    Sass_Value* list = List::Unwrap<List>(info.This())->value;
+    List* obj = List::Unwrap<List>(info.This());
+    Sass_Value* list = obj->value;
     size_t index = Nan::To<uint32_t>(info[0]).FromJust();
 
 
@@ -55,7 +56,7 @@ namespace SassTypes
       return Nan::ThrowRangeError(Nan::New("Out of bound index").ToLocalChecked());
     }
 
-    info.GetReturnValue().Set(Factory::create(sass_list_get_value(list, Nan::To<uint32_t>(info[0]).FromJust()))->get_js_object());
+    info.GetReturnValue().Set(Factory::create(sass_list_get_value(list, index), obj->root)->get_js_object());
   }
 
   NAN_METHOD(List::SetValue) {
@@ -73,7 +74,7 @@ namespace SassTypes
 
     Value* sass_value = Factory::unwrap(info[1]);
     if (sass_value) {
-      sass_list_set_value(List::Unwrap<List>(info.This())->value, Nan::To<uint32_t>(info[0]).FromJust(), sass_value->get_sass_value());
+      sass_list_set_value(List::Unwrap<List>(info.This())->mutable_value(), Nan::To<uint32_t>(info[0]).FromJust(), sass_value->get_sass_value());
     } else {
       Nan::ThrowTypeError("A SassValue is expected as the list item");
     }
@@ -92,7 +93,7 @@ namespace SassTypes
       return Nan::ThrowTypeError("Supplied value should be a boolean");
     }
 
-    sass_list_set_separator(List::Unwrap<List>(info.This())->value, Nan::To<bool>(info[0]).FromJust() ? SASS_COMMA : SASS_SPACE);
+    sass_list_set_separator(List::Unwrap<List>(info.This())->mutable_value(), Nan::To<bool>(info[0]).FromJust() ? SASS_COMMA : SASS_SPACE);
   }
 
   NAN_METHOD(List::GetLength) {
@@ -8,7 +8,7 @@ namespace SassTypes
 {
   class List : public SassValueWrapper<List> {
     public:
-      List(Sass_Value*);
+      List(Sass_Value*, ValueRoot = ValueRoot());
       static char const* get_constructor_name() { return "SassList"; }
       static Sass_Value* construct(const std::vector<v8::Local<v8::Value>>, Sass_Value **);
 
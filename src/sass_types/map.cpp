@@ -3,7 +3,7 @@
 
 namespace SassTypes
 {
-  Map::Map(Sass_Value* v) : SassValueWrapper(v) {}
+  Map::Map(Sass_Value* v, ValueRoot root) : SassValueWrapper(v, root) {}
 
   Sass_Value* Map::construct(const std::vector<v8::Local<v8::Value>> raw_val, Sass_Value **out) {
     size_t length = 0;
@@ -37,7 +37,8 @@ namespace SassTypes
       return Nan::ThrowTypeError("Supplied index should be an integer");
     }
 
-    Sass_Value* map = Map::Unwrap<Map>(info.This())->value;
+    Map* obj = Map::Unwrap<Map>(info.This());
+    Sass_Value* map = obj->value;
     size_t index = Nan::To<uint32_t>(info[0]).FromJust();
 
 
@@ -45,7 +46,7 @@ namespace SassTypes
       return Nan::ThrowRangeError(Nan::New("Out of bound index").ToLocalChecked());
     }
 
-    info.GetReturnValue().Set(Factory::create(sass_map_get_value(map, Nan::To<uint32_t>(info[0]).FromJust()))->get_js_object());
+    info.GetReturnValue().Set(Factory::create(sass_map_get_value(map, index), obj->root)->get_js_object());
   }
 
   NAN_METHOD(Map::SetValue) {
@@ -63,7 +64,7 @@ namespace SassTypes
 
     Value* sass_value = Factory::unwrap(info[1]);
     if (sass_value) {
-      sass_map_set_value(Map::Unwrap<Map>(info.This())->value, Nan::To<uint32_t>(info[0]).FromJust(), sass_value->get_sass_value());
+      sass_map_set_value(Map::Unwrap<Map>(info.This())->mutable_value(), Nan::To<uint32_t>(info[0]).FromJust(), sass_value->get_sass_value());
     } else {
       Nan::ThrowTypeError("A SassValue is expected as a map value");
     }
@@ -78,7 +79,8 @@ namespace SassTypes
       return Nan::ThrowTypeError("Supplied index should be an integer");
     }
 
-    Sass_Value* map = Map::Unwrap<Map>(info.This())->value;
+    Map* map_obj = Map::Unwrap<Map>(info.This());
+    Sass_Value* map = map_obj->value;
     size_t index = Nan::To<uint32_t>(info[0]).FromJust();
 
 
@@ -86,7 +88,7 @@ namespace SassTypes
       return Nan::ThrowRangeError(Nan::New("Out of bound index").ToLocalChecked());
     }
 
-    SassTypes::Value* obj = Factory::create(sass_map_get_key(map, Nan::To<uint32_t>(info[0]).FromJust()));
+    SassTypes::Value* obj = Factory::create(sass_map_get_key(map, index), map_obj->root);
     v8::Local<v8::Object> js_obj = obj->get_js_object();
     info.GetReturnValue().Set(js_obj);
   }
@@ -106,7 +108,7 @@ namespace SassTypes
 
     Value* sass_value = Factory::unwrap(info[1]);
     if (sass_value) {
-      sass_map_set_key(Map::Unwrap<Map>(info.This())->value, Nan::To<uint32_t>(info[0]).FromJust(), sass_value->get_sass_value());
+      sass_map_set_key(Map::Unwrap<Map>(info.This())->mutable_value(), Nan::To<uint32_t>(info[0]).FromJust(), sass_value->get_sass_value());
     } else {
       Nan::ThrowTypeError("A SassValue is expected as a map key");
     }
@@ -8,7 +8,7 @@ namespace SassTypes
 {
   class Map : public SassValueWrapper<Map> {
     public:
-      Map(Sass_Value*);
+      Map(Sass_Value*, ValueRoot = ValueRoot());
       static char const* get_constructor_name() { return "SassMap"; }
       static Sass_Value* construct(const std::vector<v8::Local<v8::Value>>, Sass_Value **);
 
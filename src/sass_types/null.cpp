@@ -3,15 +3,16 @@
 
 namespace SassTypes
 {
-  Nan::Persistent<v8::Function> Null::constructor;
-  bool Null::constructor_locked = false;
+  thread_local Nan::Persistent<v8::Function> Null::constructor;
+  thread_local bool Null::constructor_locked = false;
 
   Null::Null() {
       value = sass_make_null();
+      root.reset(value, sass_delete_value);
   }
 
   Null& Null::get_singleton() {
-    static Null singleton_instance;
+    static thread_local Null singleton_instance;
     return singleton_instance;
   }
 
@@ -39,6 +40,12 @@ namespace SassTypes
     return scope.Escape(conslocal);
   }
 
+  void Null::cleanup() {
+    get_singleton().js_object.Reset();
+    constructor.Reset();
+    constructor_locked = false;
+  }
+
   v8::Local<v8::Object> Null::get_js_object() {
     return Nan::New(this->js_object);
   }
@@ -10,6 +10,7 @@ namespace SassTypes
     public:
       static Null& get_singleton();
       static v8::Local<v8::Function> get_constructor();
+      static void cleanup();
 
       Sass_Value* get_sass_value();
       v8::Local<v8::Object> get_js_object();
@@ -21,8 +22,8 @@ namespace SassTypes
 
       Nan::Persistent<v8::Object> js_object;
 
-      static Nan::Persistent<v8::Function> constructor;
-      static bool constructor_locked;
+      static thread_local Nan::Persistent<v8::Function> constructor;
+      static thread_local bool constructor_locked;
   };
 }
 
@@ -4,7 +4,7 @@
 
 namespace SassTypes
 {
-  Number::Number(Sass_Value* v) : SassValueWrapper(v) {}
+  Number::Number(Sass_Value* v, ValueRoot root) : SassValueWrapper(v, root) {}
 
   Sass_Value* Number::construct(const std::vector<v8::Local<v8::Value>> raw_val, Sass_Value **out) {
     double value = 0;
@@ -58,7 +58,7 @@ namespace SassTypes
       return Nan::ThrowTypeError("Supplied value should be a number");
     }
 
-    sass_number_set_value(Number::Unwrap<Number>(info.This())->value, Nan::To<double>(info[0]).FromJust());
+    sass_number_set_value(Number::Unwrap<Number>(info.This())->mutable_value(), Nan::To<double>(info[0]).FromJust());
   }
 
   NAN_METHOD(Number::SetUnit) {
@@ -70,6 +70,6 @@ namespace SassTypes
       return Nan::ThrowTypeError("Supplied value should be a string");
     }
 
-    sass_number_set_unit(Number::Unwrap<Number>(info.This())->value, create_string(info[0]));
+    sass_number_set_unit(Number::Unwrap<Number>(info.This())->mutable_value(), create_string(info[0]));
   }
 }
@@ -17,20 +17,21 @@ namespace SassTypes
       public:
         static char const* get_constructor_name() { return "SassValue"; }
 
-        SassValueWrapper(Sass_Value* v) : Value(v) { }
+        SassValueWrapper(Sass_Value* v, ValueRoot root = ValueRoot()) : Value(v, root) { }
         v8::Local<v8::Object> get_js_object();
 
         static v8::Local<v8::Function> get_constructor();
         static v8::Local<v8::FunctionTemplate> get_constructor_template();
         static NAN_METHOD(New);
         static Sass_Value *fail(const char *, Sass_Value **);
+        static void cleanup();
 
         /* private: */
-        static Nan::Persistent<v8::Function> constructor;
+        static thread_local Nan::Persistent<v8::Function> constructor;
     };
 
   template <class T>
-    Nan::Persistent<v8::Function> SassValueWrapper<T>::constructor;
+    thread_local Nan::Persistent<v8::Function> SassValueWrapper<T>::constructor;
 
   template <class T>
     v8::Local<v8::Object> SassValueWrapper<T>::get_js_object() {
@@ -62,6 +63,11 @@ namespace SassTypes
       return Nan::New(constructor);
     }
 
+  template <class T>
+    void SassValueWrapper<T>::cleanup() {
+      constructor.Reset();
+    }
+
   template <class T>
     NAN_METHOD(SassValueWrapper<T>::New) {
       std::vector<v8::Local<v8::Value>> localArgs(info.Length());
@@ -4,7 +4,7 @@
 
 namespace SassTypes
 {
-  String::String(Sass_Value* v) : SassValueWrapper(v) {}
+  String::String(Sass_Value* v, ValueRoot root) : SassValueWrapper(v, root) {}
 
   Sass_Value* String::construct(const std::vector<v8::Local<v8::Value>> raw_val, Sass_Value **out) {
     char const* value = "";
@@ -43,6 +43,6 @@ namespace SassTypes
       return Nan::ThrowTypeError("Supplied value should be a string");
     }
 
-    sass_string_set_value(String::Unwrap<String>(info.This())->value, create_string(info[0]));
+    sass_string_set_value(String::Unwrap<String>(info.This())->mutable_value(), create_string(info[0]));
   }
 }
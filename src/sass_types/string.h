@@ -8,7 +8,7 @@ namespace SassTypes
 {
   class String : public SassValueWrapper<String> {
     public:
-      String(Sass_Value*);
+      String(Sass_Value*, ValueRoot = ValueRoot());
       static char const* get_constructor_name() { return "SassString"; }
       static Sass_Value* construct(const std::vector<v8::Local<v8::Value>>, Sass_Value **);
 
@@ -1,11 +1,15 @@
 #ifndef SASS_TYPES_VALUE_H
 #define SASS_TYPES_VALUE_H
 
+#include <memory>
 #include <nan.h>
 #include <sass/values.h>
 
 namespace SassTypes
 {
+  // Owner of a tree of sass values, shared by all wrappers pointing into it
+  typedef std::shared_ptr<Sass_Value> ValueRoot;
+
   // This is the interface that all sass values must comply with
   class Value : public Nan::ObjectWrap {
 
@@ -23,13 +27,23 @@ namespace SassTypes
     protected:
 
       Sass_Value* value;
+      ValueRoot root;
 
-      Value(Sass_Value* v) {
-        this->value = sass_clone_value(v);
+      // Without a root the value is copied. With a root the wrapper is a
+      // view into a tree owned elsewhere, e.g. an item read from a list or
+      // a map, so reading large lists and maps copies nothing.
+      Value(Sass_Value* v, ValueRoot r = ValueRoot())
+      : value(r ? v : sass_clone_value(v)), root(r ? r : ValueRoot(value, sass_delete_value)) {
       }
 
-      ~Value() {
-        sass_delete_value(this->value);
+      // Views get their own copy before they are changed, so changes
+      // don't show through the container or other views of the item.
+      Sass_Value* mutable_value() {
+        if (this->value != this->root.get()) {
+          this->value = sass_clone_value(this->value);
+          this->root.reset(this->value, sass_delete_value);
+        }
+        return this->value;
       }
 
       static Sass_Value* fail(const char *reason, Sass_Value **out) {
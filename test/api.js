@@ -281,6 +281,65 @@ describe('api', function() {
         done();
       });
     });
+
+    it('should produce the same output for many concurrent renders', function(done) {
+      var src = [
+        '$id: unique-id();',
+        '@mixin button($color) { color: $color; border-color: darken($color, 10%); }',
+        '%base { margin: 0; }',
+        '@each $name in (royalblue, crimson) { .btn-#{$name} { @extend %base; @include button($name); } }',
+        '.random { valid: random() < 1; id: str-length($id) > 0; }'
+      ].join('\n');
+      var expected = sass.renderSync({ data: src }).css.toString();
+      var pending = 64;
+
+      for (var i = 0; i < 64; i++) {
+        sass.render({ data: src, memoizeMixins: i % 2 === 0 }, function(error, result) {
+          assert.strictEqual(error, null);
+          assert.strictEqual(result.css.toString(), expected);
+          if (--pending === 0) {
+            done();
+          }
+        });
+      }
+    });
+
+    it('should render concurrently from worker threads', function(done) {
+      var Worker = require('worker_threads').Worker;
+      var code = [
+        'var sass = require(require("worker_threads").workerData.sassPath);',
+        'var parentPort = require("worker_threads").parentPort;',
+        'sass.render({',
+        '  data: "@import \'colors\'; div { color: shade($primary); visible: is-null(null); }",',
+        '  importer: function(url, prev, done) { done({ contents: "$primary: royalblue;" }); },',
+        '  functions: { "shade($c)": function(c) {',
+        '    return new sass.types.Color(c.getR() >> 1, c.getG() >> 1, c.getB() >> 1); },',
+        '    "is-null($v)": function(v) { return sass.types.Boolean(v === sass.NULL); } }',
+        '}, function(error, result) {',
+        '  parentPort.postMessage(error ? error.message : result.css.toString());',
+        '});'
+      ].join('\n');
+      var expected = 'div {\n  color: #203470;\n  visible: true; }\n';
+      var pending = 8;
+      var received = 0;
+
+      for (var i = 0; i < 8; i++) {
+        new Worker(code, { eval: true, workerData: { sassPath: sassPath } })
+          .on('message', function(css) {
+            assert.strictEqual(css, expected);
+            received++;
+          })
+          .on('error', function(error) {
+            assert.fail(error);
+          })
+          .on('exit', function() {
+            if (--pending === 0) {
+              assert.strictEqual(received, 8);
+              done();
+            }
+          });
+      }
+    });
   });
 
   describe('.render(importer)', function() {
@@ -1324,6 +1383,93 @@ describe('api', function() {
         done();
       });
     });
+
+    it('should not mix up the counters of concurrent renders', function(done) {
+      var data = read(fixture('simple/index.scss'), 'utf8');
+      var expected = sass.renderSync({ data: data }).stats.counters.allocatedNodes;
+      var pending = 8;
+
+      for (var i = 0; i < 8; i++) {
+        sass.render({ data: data }, function(error, result) {
+          assert(!error);
+          assert.strictEqual(result.stats.counters.allocatedNodes, expected);
+          if (--pending === 0) {
+            done();
+          }
+        });
+      }
+    });
+  });
+
+  describe('.render({signal})', function() {
+    var endless = '$i: 0; @while $i < 100000000 { $i: $i + 1; } a { b: $i; }';
+
+    it('should release the worker within milliseconds of the abort', function(done) {
+      var controller = new AbortController();
+      var aborted;
+
+      sass.render({
+        data: endless,
+        signal: controller.signal
+      }, function(error, result) {
+        var elapsed = Date.now() - aborted;
+        assert(!result);
+        assert.strictEqual(error.status, 6);
+        assert.strictEqual(error.message, 'Compilation cancelled');
+        assert(elapsed < 100, 'released after ' + elapsed + 'ms');
+        done();
+      });
+
+      setTimeout(function() {
+        aborted = Date.now();
+        controller.abort();
+      }, 50);
+    });
+
+    it('should not compile with an aborted signal', function(done) {
+      var controller = new AbortController();
+      controller.abort();
+
+      sass.render({
+        file: fixture('include-files/index.scss'),
+        signal: controller.signal
+      }, function(error) {
+        assert.strictEqual(error.status, 6);
+        done();
+      });
+    });
+
+    it('should cancel all variants', function(done) {
+      var controller = new AbortController();
+
+      sass.renderVariants({
+        data: endless,
+        variants: [{ prelude: '$a: 1;' }, { prelude: '$a: 2;' }],
+        signal: controller.signal
+      }, function(error) {
+        assert.strictEqual(error.status, 6);
+        done();
+      });
+
+      setTimeout(function() {
+        controller.abort();
+      }, 50);
+    });
+
+    it('should ignore an abort once rendered', function(done) {
+      var controller = new AbortController();
+      var expected = read(fixture('simple/expected.css'), 'utf8').trim();
+
+      sass.render({
+        file: fixture('simple/index.scss'),
+        signal: controller.signal
+      }, function(error, result) {
+        assert(!error);
+        assert.strictEqual(result.css.toString().trim(), expected.replace(/\r\n/g, '\n'));
+        controller.abort();
+        setTimeout(done, 10);
+      });
+    });
   });
 
   describe('.renderSync(options)', function() {
@@ -1823,6 +1969,49 @@ describe('api', function() {
       done();
     });
 
+    it('should cache the results of pure custom functions', function(done) {
+      var calls = 0;
+      var result = sass.renderSync({
+        data: '@for $i from 1 through 10 { .a-#{$i} { width: rem(32px); height: rem($i * 16px); } }',
+        functions: {
+          'rem($px)': {
+            pure: true,
+            fn: function(px) {
+              calls++;
+              return new sass.types.Number(px.getValue() / 16, 'rem');
+            }
+          }
+        }
+      });
+
+      assert.ok(result.css.toString().indexOf('.a-10 {\n  width: 2rem;\n  height: 10rem; }') !== -1);
+      assert.strictEqual(calls, 10);
+      assert.strictEqual(result.stats.counters.customFunctionCalls, 10);
+      assert.strictEqual(result.stats.counters.customFunctionCacheHits, 10);
+      done();
+    });
+
+    it('should not change a map when a value read from it is changed', function(done) {
+      var kept;
+      var result = sass.renderSync({
+        data: 'div { a: change((width: 10px, height: 20px)); b: change((width: 1px)); }',
+        functions: {
+          'change($map)': function(map) {
+            var width = map.getValue(0);
+            width.setValue(width.getValue() * 2);
+            kept = kept || map;
+            return new sass.types.Number(map.getValue(0).getValue() + width.getValue(), 'px');
+          }
+        }
+      });
+
+      assert.strictEqual(result.css.toString().trim(), 'div {\n  a: 30px;\n  b: 3px; }');
+      assert.strictEqual(kept.getLength(), 2);
+      assert.strictEqual(kept.getKey(1).getValue(), 'height');
+      assert.strictEqual(kept.getValue(1).getValue(), 20);
+      done();
+    });
+
     it('should let custom function invoke sass types constructors without the `new` keyword', function(done) {
       var result = sass.renderSync({
         data: 'div { color: foo(); }',
@@ -2015,6 +2204,695 @@ describe('api', function() {
       assert.deepStrictEqual(result.stats.includedFiles, []);
       done();
     });
+
+    it('should contain the time spent in each phase', function(done) {
+      var phases = ['parse', 'expand', 'checkNesting', 'cssize', 'extend', 'removePlaceholders', 'output'];
+
+      assert.deepStrictEqual(Object.keys(result.stats.phases), phases);
+      phases.forEach(function(phase) {
+        assert(result.stats.phases[phase] >= 0);
+      });
+      done();
+    });
+
+    it('should contain the parse time of every included file', function(done) {
+      var actual = Object.keys(result.stats.parseTimes).map(function(file) {
+        return file.replace(/\\/g, '/');
+      });
+
+      assert.deepStrictEqual(actual.sort(), result.stats.includedFiles.sort());
+      done();
+    });
+
+    it('should contain compile counters', function(done) {
+      var result = sass.renderSync({
+        data: '@mixin m($c) { color: darken($c, 5%); } .a { @include m(red); } .b { @extend .a; }'
+      });
+
+      assert.strictEqual(result.stats.counters.functionCalls, 1);
+      assert.strictEqual(result.stats.counters.mixinIncludes, 1);
+      assert(result.stats.counters.extendLookups > 0);
+      assert(result.stats.counters.allocatedNodes > 0);
+      assert.strictEqual(result.stats.counters.outputBytes, result.css.length);
+      done();
+    });
+  });
+
+  describe('.renderSync({memoizeFunctions: true})', function() {
+    var src = [
+      '$brand: #3366cc;',
+      '@for $i from 1 through 10 {',
+      '  .a-#{$i} { color: darken($brand, 10%); width: percentage(0.5); id: unique-id(); }',
+      '}'
+    ].join('\n');
+
+    it('should produce the same output as without the cache', function(done) {
+      var plain = sass.renderSync({ data: src.replace('id: unique-id();', '') });
+      var memoized = sass.renderSync({ data: src.replace('id: unique-id();', ''), memoizeFunctions: true });
+
+      assert.strictEqual(memoized.css.toString(), plain.css.toString());
+      done();
+    });
+
+    it('should report cache hits and misses in stats', function(done) {
+      var result = sass.renderSync({ data: src, memoizeFunctions: true });
+
+      assert.strictEqual(result.stats.callCache.misses, 2);
+      assert.strictEqual(result.stats.callCache.hits, 18);
+      done();
+    });
+
+    it('should never cache impure functions', function(done) {
+      var result = sass.renderSync({ data: src, memoizeFunctions: true });
+      var ids = result.css.toString().match(/id: \w+/g);
+
+      assert.strictEqual(ids.length, 10);
+      assert.strictEqual(new Set(ids).size, 10);
+      done();
+    });
+
+    it('should not use the cache by default', function(done) {
+      var result = sass.renderSync({ data: src });
+
+      assert.strictEqual(result.stats.callCache.hits, 0);
+      assert.strictEqual(result.stats.callCache.misses, 0);
+      done();
+    });
+
+    describe('with user-defined functions', function() {
+      var src = [
+        '$base: 16px;',
+        '@function rem($px) { @return $px / $base * 1rem; }',
+        '@function count($x) { $calls: 1 !global; @return $x; }',
+        '@for $i from 1 through 5 { .a-#{$i} { width: rem(32px); height: count(1px); } }',
+        '$base: 8px;',
+        '.b { width: rem(32px); }'
+      ].join('\n');
+
+      it('should cache pure functions until a global they read changes', function(done) {
+        var plain = sass.renderSync({ data: src });
+        var result = sass.renderSync({ data: src, memoizeFunctions: true });
+
+        assert.strictEqual(result.css.toString(), plain.css.toString());
+        assert.strictEqual(result.stats.callCache.misses, 2);
+        assert.strictEqual(result.stats.callCache.hits, 4);
+        done();
+      });
+
+      it('should report the purity analysis in stats', function(done) {
+        var result = sass.renderSync({ data: src, memoizeFunctions: true });
+
+        assert.strictEqual(result.stats.callCache.pureFunctions, 1);
+        assert.strictEqual(result.stats.callCache.impureFunctions, 1);
+        done();
+      });
+
+      it('should produce the same source map as without the cache', function(done) {
+        var options = { data: src, outFile: 'index.css', sourceMap: 'index.css.map' };
+        var plain = sass.renderSync(options);
+        var result = sass.renderSync(Object.assign({ memoizeFunctions: true }, options));
+
+        assert.strictEqual(result.map.toString(), plain.map.toString());
+        done();
+      });
+    });
+  });
+
+  describe('.renderSync({memoizeMixins: true})', function() {
+    var src = [
+      '$pad: 4px;',
+      '@mixin size($w, $h) { width: $w; height: $h; }',
+      '@mixin padded { padding: $pad; }',
+      '@mixin hover { &:hover { color: red; } }',
+      '@for $i from 1 through 3 { .a-#{$i} { @include size(1px, 2px); @include padded; @include hover; } }',
+      '$pad: 8px;',
+      '.b { @include padded; }'
+    ].join('\n');
+
+    it('should produce the same output as without the cache', function(done) {
+      var plain = sass.renderSync({ data: src });
+      var memoized = sass.renderSync({ data: src, memoizeMixins: true });
+
+      assert.strictEqual(memoized.css.toString(), plain.css.toString());
+      done();
+    });
+
+    it('should report cache hits and misses in stats', function(done) {
+      var result = sass.renderSync({ data: src, memoizeMixins: true });
+
+      assert.strictEqual(result.stats.mixinCache.misses, 6);
+      assert.strictEqual(result.stats.mixinCache.hits, 4);
+      done();
+    });
+
+    it('should cache nested rules per parent selector', function(done) {
+      var src = [
+        '@mixin button($c) { color: $c; &:hover { color: darken($c, 10%); } @content; }',
+        '.btn { @include button(red); }',
+        '@media print { .btn { @include button(red); } }',
+        '.link { @include button(red); }',
+        '.c { @extend .btn; }'
+      ].join('\n');
+      var plain = sass.renderSync({ data: src });
+      var result = sass.renderSync({ data: src, memoizeMixins: true });
+
+      assert.strictEqual(result.css.toString(), plain.css.toString());
+      assert.strictEqual(result.stats.mixinCache.misses, 2);
+      assert.strictEqual(result.stats.mixinCache.hits, 1);
+      done();
+    });
+
+    it('should only reuse nested rules under the same parent selector', function(done) {
+      var src = [
+        '@mixin button($c) { color: $c; &:hover { color: darken($c, 10%); } }',
+        '@mixin size($w) { width: $w; height: $w; }',
+        '@each $bp in 400px, 800px, 1200px {',
+        '  @media (min-width: $bp) {',
+        '    .btn { @include button(red); @include size(10px); }',
+        '    .btn-alt { @include button(blue); @include size(10px); }',
+        '  }',
+        '}',
+        '@for $i from 1 through 4 { .icon-#{$i} { @include button(red); @include size(10px); } }'
+      ].join('\n');
+      var plain = sass.renderSync({ data: src });
+      var result = sass.renderSync({ data: src, memoizeMixins: true });
+
+      assert.strictEqual(result.css.toString(), plain.css.toString());
+      // button() misses once per parent selector (.btn, .btn-alt and
+      // each .icon-N), size() only on its first include
+      assert.strictEqual(result.stats.mixinCache.misses, 7);
+      assert.strictEqual(result.stats.mixinCache.hits, 13);
+      done();
+    });
+
+    it('should not use the cache with source maps', function(done) {
+      var result = sass.renderSync({ data: src, memoizeMixins: true, outFile: 'out.css', sourceMap: true });
+
+      assert.strictEqual(result.stats.mixinCache.hits, 0);
+      assert.strictEqual(result.stats.mixinCache.misses, 0);
+      done();
+    });
+  });
+
+  describe('.renderSync({parseThreads})', function() {
+    function formatted(options) {
+      try {
+        sass.renderSync(options);
+      } catch (err) {
+        return err.formatted;
+      }
+    }
+
+    it('should produce the same output as a serial parse', function(done) {
+      var options = { file: fixture('depth-first/index.scss'), outFile: 'index.css', sourceMap: true };
+      var serial = sass.renderSync(options);
+      var parallel = sass.renderSync(Object.assign({ parseThreads: 4 }, options));
+
+      assert.strictEqual(parallel.css.toString(), serial.css.toString());
+      assert.strictEqual(parallel.map.toString(), serial.map.toString());
+      assert.deepStrictEqual(parallel.stats.includedFiles, serial.stats.includedFiles);
+      assert.deepStrictEqual(parallel.stats.imports, serial.stats.imports);
+      done();
+    });
+
+    it('should report errors with the same backtrace', function(done) {
+      var options = { data: '@import "a";\n@import "nope";', includePaths: [fixture('depth-first')] };
+      var serial = formatted(options);
+
+      assert(serial);
+      assert.strictEqual(formatted(Object.assign({ parseThreads: 4 }, options)), serial);
+      done();
+    });
+  });
+
+  describe('.renderSync({outputThreads})', function() {
+    // enough top level blocks to be split up
+    var src = ['$list: 1px 2px;', '@import url("a.css");', '/* leading */'];
+    for (var i = 0; i < 200; i++) {
+      src.push(
+        '.a' + i + ' { b: $list; &:hover { c: "\u00fc"; } }',
+        i % 7 ? '@media (min-width: ' + i + 'px) { .m' + i + ' { d: e; } }' : '/* comment ' + i + ' */',
+        i % 11 ? '%p' + i + ' { f: g; }' : '@import url("b' + i + '.css");'
+      );
+    }
+    src = src.join('\n');
+
+    ['nested', 'expanded', 'compact', 'compressed'].forEach(function(style) {
+      it('should produce the same ' + style + ' output as a serial render', function(done) {
+        var options = { data: src, outputStyle: style, outFile: 'index.css', sourceMap: true };
+        var serial = sass.renderSync(options);
+        var parallel = sass.renderSync(Object.assign({ outputThreads: 4 }, options));
+
+        assert.strictEqual(parallel.css.toString(), serial.css.toString());
+        assert.strictEqual(parallel.map.toString(), serial.map.toString());
+        done();
+      });
+    });
+
+    it('should report errors of later blocks', function(done) {
+      assert.throws(function() {
+        sass.renderSync({ data: src + '\n.z { w: 1px * 1px; }', outputThreads: 4 });
+      }, function(err) {
+        return /1px\*px isn't a valid CSS value/.test(err.message);
+      });
+      done();
+    });
+  });
+
+  describe('.renderSync({extendThreads})', function() {
+    // enough top level blocks to be split up
+    var src = ['%base { a: b; }', '.shared { c: d; }'];
+    for (var i = 0; i < 200; i++) {
+      src.push(
+        '.a' + i + ' { @extend %base; e: f; .b' + (i % 13) + ' & { g: h; } }',
+        '.c' + i + ':not(.a' + (i % 5) + ') { @extend .shared; }',
+        i % 7 ? '@media (min-width: ' + i + 'px) { .m' + i + ' { k: l; } .n' + i + ' { @extend .m' + i + '; } }' : '.x' + i + ' > .a' + i + ' { i: j; }'
+      );
+    }
+    src = src.join('\n');
+
+    ['nested', 'expanded', 'compact', 'compressed'].forEach(function(style) {
+      it('should produce the same ' + style + ' output as a serial extend', function(done) {
+        var options = { data: src, outputStyle: style, outFile: 'index.css', sourceMap: true };
+        var serial = sass.renderSync(options);
+        var parallel = sass.renderSync(Object.assign({ extendThreads: 4 }, options));
+
+        assert.strictEqual(parallel.css.toString(), serial.css.toString());
+        assert.strictEqual(parallel.map.toString(), serial.map.toString());
+        done();
+      });
+    });
+
+    it('should report @extends that matched nothing', function(done) {
+      assert.throws(function() {
+        sass.renderSync({ data: src + '\n.z { @extend .nope; }', extendThreads: 4 });
+      }, function(err) {
+        return /The selector "\.nope" was not found/.test(err.message);
+      });
+      done();
+    });
+
+    it('should stop the other chunks once one fails', function(done) {
+      // the rulesets at the end take minutes to extend, a serial
+      // extend fails at the @media before it gets there
+      var failing = [];
+      for (var i = 0; i < 40; i++) {
+        failing.push('.r' + i + ' { a: b; }');
+      }
+      failing.push('.t { color: red; }', '@media print { .m { @extend .t; } }');
+      for (i = 0; i < 40; i++) {
+        failing.push('.s' + i + ' { a: b; }');
+      }
+      for (i = 0; i < 10; i++) {
+        failing.push('.a' + i + ' .b' + i + ' { @extend .h; }');
+      }
+      failing.push('.x1 .h .x2 .h .x3 .h .x4 .h { color: blue; }');
+
+      var start = Date.now();
+      assert.throws(function() {
+        sass.renderSync({ data: failing.join('\n'), extendThreads: 4 });
+      }, function(err) {
+        return /You may not @extend an outer selector from within @media/.test(err.message);
+      });
+      assert(Date.now() - start < 2000);
+      done();
+    });
+  });
+
+  describe('.renderSync({timeLimit, nodeLimit, outputLimit})', function() {
+    var src = '@for $i from 1 through 500 { .a#{$i} { b: $i; } }';
+
+    function assertLimit(options, limit) {
+      assert.throws(function() {
+        sass.renderSync(options);
+      }, function(err) {
+        return err.status === 7 && err.limit === limit;
+      });
+    }
+
+    it('should stop an endless loop at the time limit', function(done) {
+      var start = Date.now();
+      assertLimit({ data: '$i: 0; @while $i < 100000000 { $i: $i + 1; }', timeLimit: 50 }, 'time');
+      assert(Date.now() - start < 1000);
+      done();
+    });
+
+    it('should stop at the node limit', function(done) {
+      var nodes = sass.renderSync({ data: src }).stats.counters.allocatedNodes;
+      assertLimit({ data: src, nodeLimit: Math.floor(nodes / 2) }, 'nodes');
+      done();
+    });
+
+    it('should stop at the output limit', function(done) {
+      var bytes = sass.renderSync({ data: src }).css.length;
+      assertLimit({ data: src, outputLimit: bytes - 1 }, 'output');
+      assertLimit({ data: src, outputLimit: bytes - 1, outputThreads: 4 }, 'output');
+      done();
+    });
+
+    it('should render within the limits', function(done) {
+      var expected = sass.renderSync({ data: src }).css.toString();
+      var result = sass.renderSync({
+        data: src,
+        timeLimit: 60000,
+        nodeLimit: 100000000,
+        outputLimit: expected.length
+      });
+
+      assert.strictEqual(result.css.toString(), expected);
+      done();
+    });
+
+    it('should report the limit from render', function(done) {
+      sass.render({ data: src, outputLimit: 10 }, function(error) {
+        assert.strictEqual(error.status, 7);
+        assert.strictEqual(error.limit, 'output');
+        assert.strictEqual(error.message, 'Output limit of 10 bytes exceeded');
+        done();
+      });
+    });
+  });
+
+  describe('.renderSync({importerResultCache})', function() {
+    // colorBlue is declined and found on the include path
+    var src = '@import "a"; @import "colorBlue";';
+
+    function countingImporter(calls) {
+      return function(url) {
+        calls.push(url);
+        return url === 'a' ? { contents: 'a { b: c; }' } : null;
+      };
+    }
+
+    it('should reuse importer results across renders', function(done) {
+      var calls = [];
+      var cache = new sass.ImporterResultCache();
+      var options = {
+        data: src,
+        includePaths: [fixture('include-path/functions')],
+        importer: countingImporter(calls),
+        importerResultCache: cache
+      };
+
+      var first = sass.renderSync(options).css.toString();
+      var second = sass.renderSync(options).css.toString();
+
+      assert.strictEqual(second, first);
+      assert.deepStrictEqual(calls, ['a', 'colorBlue']);
+      assert.deepStrictEqual(cache.getStats(), { entries: 2, hits: 2, misses: 2 });
+      done();
+    });
+
+    it('should call the importer again once results are dropped', function(done) {
+      var calls = [];
+      var cache = new sass.ImporterResultCache();
+      var options = {
+        data: src,
+        includePaths: [fixture('include-path/functions')],
+        importer: countingImporter(calls),
+        importerResultCache: cache
+      };
+
+      sass.renderSync(options);
+      assert.strictEqual(cache.delete('a'), 1);
+      sass.renderSync(options);
+      assert.deepStrictEqual(calls, ['a', 'colorBlue', 'a']);
+
+      cache.clear();
+      sass.renderSync(options);
+      assert.deepStrictEqual(calls, ['a', 'colorBlue', 'a', 'a', 'colorBlue']);
+      assert.strictEqual(cache.getStats().entries, 2);
+      done();
+    });
+
+    it('should keep the results of other importers apart', function(done) {
+      var cache = new sass.ImporterResultCache();
+      var first = function() {
+        return { contents: 'a { b: first; }' };
+      };
+      var second = function() {
+        return { contents: 'a { b: second; }' };
+      };
+
+      sass.renderSync({ data: '@import "a";', importer: [first], importerResultCache: cache });
+      var result = sass.renderSync({ data: '@import "a";', importer: [second, first], importerResultCache: cache });
+
+      assert.strictEqual(result.css.toString().trim(), 'a {\n  b: second; }');
+      assert.deepStrictEqual(cache.getStats(), { entries: 2, hits: 0, misses: 2 });
+
+      result = sass.renderSync({ data: '@import "a";', importer: first, importerResultCache: cache });
+      assert.strictEqual(result.css.toString().trim(), 'a {\n  b: first; }');
+      assert.strictEqual(cache.getStats().hits, 1);
+      done();
+    });
+
+    it('should not cache importer errors', function(done) {
+      var calls = 0;
+      var cache = new sass.ImporterResultCache();
+      var options = {
+        data: '@import "a";',
+        importer: function() {
+          calls++;
+          return new Error('nope');
+        },
+        importerResultCache: cache
+      };
+
+      assert.throws(function() { sass.renderSync(options); });
+      assert.throws(function() { sass.renderSync(options); });
+      assert.strictEqual(calls, 2);
+      assert.strictEqual(cache.getStats().entries, 0);
+      done();
+    });
+  });
+
+  describe('.renderSync({pluginPaths})', function() {
+    // built next to the binding by node-gyp, or with make -C src/libsass plugin
+    var plugins = [
+      path.join(__dirname, '..', 'build', 'Release', 'plugins'),
+      path.join(__dirname, '..', 'build', 'Debug', 'plugins'),
+      path.join(__dirname, '..', 'src', 'libsass', 'contrib', 'plugins')
+    ].filter(function(dir) {
+      return fs.existsSync(dir);
+    })[0];
+
+    it('should ignore plugin paths that do not exist', function(done) {
+      var result = sass.renderSync({ data: 'a { b: c; }', pluginPaths: [fixture('nope')] });
+
+      assert.strictEqual(result.css.toString().trim(), 'a {\n  b: c; }');
+      done();
+    });
+
+    it('should call functions of the sample plugin', function() {
+      if (!plugins && process.env.SASS_BINARY_PATH) {
+        // a prebuilt binding comes without the sample plugin
+        this.skip();
+      }
+      assert.ok(plugins, 'the sample plugin was not built with the binding');
+
+      var result = sass.renderSync({
+        data: 'a { b: rem(24px); c: rem(24px); d: foo(); }',
+        pluginPaths: [plugins]
+      });
+
+      assert.strictEqual(result.css.toString().trim(), 'a {\n  b: 1.5rem;\n  c: 1.5rem;\n  d: 42px; }');
+      assert.strictEqual(result.stats.counters.customFunctionCalls, 2);
+      assert.strictEqual(result.stats.counters.customFunctionCacheHits, 1);
+    });
+  });
+
+  describe('.renderSync({profile})', function() {
+    var src = [
+      '@function double($n) { @return $n * 2; }',
+      '@mixin size($w) { width: double($w); height: percentage(0.5); }',
+      '.a { @include size(1px); }',
+      '.b { @include size(2px); }'
+    ].join('\n');
+
+    it('should not report a profile by default', function(done) {
+      var result = sass.renderSync({ data: src });
+
+      assert.strictEqual(result.profile, undefined);
+      done();
+    });
+
+    it('should report calls per definition as a flat table', function(done) {
+      var result = sass.renderSync({ data: src, profile: 'flat' });
+
+      assert(/^\s+2 .* double \(function, stdin:1\)$/m.test(result.profile));
+      assert(/^\s+2 .* size \(mixin, stdin:2\)$/m.test(result.profile));
+      assert(/^\s+2 .* percentage \(function\)$/m.test(result.profile));
+      assert(/^\s+calls\s+inclusive ms\s+exclusive ms\s+name$/m.test(result.profile));
+      done();
+    });
+
+    it('should report every call as a trace event', function(done) {
+      var result = sass.renderSync({ data: src, profile: 'trace' });
+      var events = JSON.parse(result.profile).traceEvents;
+
+      assert.strictEqual(events.length, 6);
+      assert.deepStrictEqual(events.map(function(e) { return e.name; }),
+        ['double', 'percentage', 'size', 'double', 'percentage', 'size']);
+      assert.strictEqual(events[2].cat, 'mixin');
+      assert.strictEqual(events[2].ph, 'X');
+      assert.strictEqual(events[2].args.line, 2);
+      done();
+    });
+  });
+
+  describe('.dependencies()', function() {
+    var dir = fixture('depth-first');
+    var expected = {};
+    expected[path.join(dir, 'index.scss')] = ['a.scss', '_common.scss', 'b.scss'];
+    expected[path.join(dir, 'a.scss')] = ['_common.scss', 'a1.scss'];
+    expected[path.join(dir, '_common.scss')] = ['_vars.scss', '_struct.scss'];
+    expected[path.join(dir, 'b.scss')] = ['b1.scss'];
+    expected[path.join(dir, 'a1.scss')] = [];
+    expected[path.join(dir, 'b1.scss')] = [];
+    expected[path.join(dir, '_vars.scss')] = [];
+    expected[path.join(dir, '_struct.scss')] = [];
+    Object.keys(expected).forEach(function(file) {
+      expected[file] = expected[file].map(function(child) {
+        return path.join(dir, child);
+      });
+    });
+
+    it('should resolve the import graph of an entry', function(done) {
+      sass.dependencies(path.join(dir, 'index.scss'), function(err, graph) {
+        assert.ifError(err);
+        assert.deepStrictEqual(graph, expected);
+        done();
+      });
+    });
+
+    it('should merge the import graphs of several entries', function(done) {
+      sass.dependencies([path.join(dir, 'a.scss'), path.join(dir, 'b.scss')], {}, function(err, graph) {
+        assert.ifError(err);
+        assert.deepStrictEqual(Object.keys(graph).sort(), [
+          'a.scss', 'a1.scss', '_common.scss', '_vars.scss', '_struct.scss', 'b.scss', 'b1.scss'
+        ].map(function(file) { return path.join(dir, file); }).sort());
+        assert.deepStrictEqual(graph[path.join(dir, 'b.scss')], [path.join(dir, 'b1.scss')]);
+        done();
+      });
+    });
+
+    it('should not evaluate the stylesheets', function(done) {
+      var graph = sass.dependenciesSync(fixture('invalid/index.scss'));
+
+      assert.deepStrictEqual(Object.keys(graph), [fixture('invalid/index.scss')]);
+      assert.deepStrictEqual(graph[fixture('invalid/index.scss')], []);
+      done();
+    });
+
+    it('should fail for files that cannot be found', function(done) {
+      sass.dependencies(fixture('depth-first/nope.scss'), function(err) {
+        assert(err instanceof Error);
+        done();
+      });
+    });
+
+    it('should report the import graph of a render', function(done) {
+      var result = sass.renderSync({ file: path.join(dir, 'index.scss') });
+
+      assert.deepStrictEqual(result.stats.imports, expected);
+      done();
+    });
+  });
+
+  describe('.renderVariants()', function() {
+    var src = '$brand: blue !default; $size: 1px !default; .a { color: $brand; b: $size * 2; }';
+
+    it('should compile the input once per variant', function(done) {
+      sass.renderVariants({
+        data: src,
+        variants: [
+          { prelude: '$brand: red;' },
+          { prelude: '$size: 3px;', outputStyle: 'compressed' },
+          {}
+        ]
+      }, function(err, results) {
+        assert.ifError(err);
+        assert.strictEqual(results.length, 3);
+        assert.strictEqual(results[0].css.toString().trim(), '.a {\n  color: red;\n  b: 2px; }');
+        assert.strictEqual(results[1].css.toString().trim(), '.a{color:blue;b:6px}');
+        assert.strictEqual(results[2].css.toString(), sass.renderSync({ data: src }).css.toString());
+        done();
+      });
+    });
+
+    it('should compile the variants of a file like renders of it', function(done) {
+      var file = fixture('include-files/index.scss');
+      var styles = ['nested', 'expanded', 'compact', 'compressed'];
+      var results = sass.renderVariantsSync({
+        file: file,
+        variants: styles.map(function(style) {
+          return { outputStyle: style };
+        })
+      });
+
+      styles.forEach(function(style, i) {
+        var expected = sass.renderSync({ file: file, outputStyle: style });
+        assert.strictEqual(results[i].css.toString(), expected.css.toString());
+        assert.deepStrictEqual(results[i].stats.includedFiles, expected.stats.includedFiles);
+      });
+      done();
+    });
+
+    it('should report the variant that failed', function(done) {
+      sass.renderVariants({
+        data: src,
+        variants: [{ prelude: '$size: 1px;' }, { prelude: '$size: 1em; $brand: 2px + $size;' }]
+      }, function(err) {
+        assert(err instanceof Error);
+        assert.strictEqual(err.variant, 1);
+        done();
+      });
+    });
+  });
+
+  describe('.getHeapStats()', function() {
+    var src = '@mixin m($c) { a { color: darken($c, 10%); } } .b { @include m(red); }';
+
+    before(function() {
+      sass.setHeapTracking(true);
+    });
+
+    after(function() {
+      sass.setHeapTracking(false);
+    });
+
+    it('should count nodes per type', function(done) {
+      sass.renderSync({ data: src });
+      var stats = sass.getHeapStats();
+
+      assert(stats.types.Block.total > 0);
+      assert(stats.types.Ruleset.total > 0);
+      assert(stats.total >= stats.live);
+      done();
+    });
+
+    it('should release all nodes after a render', function(done) {
+      sass.renderSync({ data: src });
+      var before = sass.getHeapStats();
+      sass.renderSync({ data: src });
+      var after = sass.getHeapStats();
+
+      assert.strictEqual(after.live, before.live);
+      assert(after.total > before.total);
+      done();
+    });
+
+    it('should not count nodes while tracking is off', function(done) {
+      sass.setHeapTracking(false);
+      var before = sass.getHeapStats();
+      sass.renderSync({ data: src });
+      var after = sass.getHeapStats();
+      sass.setHeapTracking(true);
+
+      assert.strictEqual(after.total, before.total);
+      assert.strictEqual(after.live, before.live);
+      done();
+    });
   });
 
   describe('.info', function() {
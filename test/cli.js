@@ -1,5 +1,7 @@
 var assert = require('assert').strict,
   fs = require('fs'),
+  net = require('net'),
+  os = require('os'),
   path = require('path'),
   read = require('fs').readFileSync,
   glob = require('glob'),
@@ -790,4 +792,163 @@ describe('cli', function() {
       });
     });
   });
+
+  describe('node-sass --connect socket in.scss', function() {
+    var socket, server;
+
+    beforeEach(function(done) {
+      socket = process.platform === 'win32' ?
+        '\\\\.\\pipe\\node-sass-' + process.pid :
+        path.join(os.tmpdir(), 'node-sass-' + process.pid + '.sock');
+      server = spawn(cli, ['--server', socket]);
+      server.stdout.once('data', function() {
+        done();
+      });
+    });
+
+    afterEach(function() {
+      server.kill();
+    });
+
+    it('should compile through the compile server', function(done) {
+      var src = fixture('simple/index.scss');
+      var dest = fixture('simple/index.css');
+      var expected = read(fixture('simple/expected.css'), 'utf8').trim().replace(/\r\n/g, '\n');
+      var bin = spawn(cli, ['--connect', socket, src, dest]);
+
+      bin.once('close', function(code) {
+        assert.strictEqual(code, 0);
+        assert.strictEqual(read(dest, 'utf8').trim(), expected);
+        fs.unlinkSync(dest);
+        done();
+      });
+    });
+
+    it('should load custom functions on the compile server', function(done) {
+      var dest = fixture('custom-functions/setter.css');
+      var src = fixture('custom-functions/setter.scss');
+      var expected = read(fixture('custom-functions/setter-expected.css'), 'utf8').trim().replace(/\r\n/g, '\n');
+      var bin = spawn(cli, [
+        '--connect', socket, src, '--output', path.dirname(dest),
+        '--functions', fixture('extras/my_custom_functions_setter.js')
+      ]);
+
+      bin.once('close', function() {
+        assert.strictEqual(read(dest, 'utf8').trim(), expected);
+        fs.unlinkSync(dest);
+        done();
+      });
+    });
+
+    it('should reuse importer results until the imported file changes', function(done) {
+      var dir = fs.mkdtempSync(path.join(os.tmpdir(), 'node-sass-importer-'));
+      var src = path.join(dir, 'index.scss');
+      var partial = path.join(dir, 'theme.scss');
+      var importer = path.join(dir, 'importer.js');
+      var calls = path.join(dir, 'calls.log');
+
+      fs.writeFileSync(src, '@import "theme";');
+      fs.writeFileSync(partial, 'a { color: red; }');
+      fs.writeFileSync(importer, [
+        'var fs = require("fs");',
+        'module.exports = function(url) {',
+        '  fs.appendFileSync(' + JSON.stringify(calls) + ', url + "\\n");',
+        '  return { file: ' + JSON.stringify(partial) + ', contents: fs.readFileSync(' + JSON.stringify(partial) + ', "utf8") };',
+        '};'
+      ].join('\n'));
+
+      function compile(callback) {
+        var bin = spawn(cli, ['--connect', socket, src, '--importer', importer]);
+        var output = '';
+
+        bin.stdout.setEncoding('utf8');
+        bin.stdout.on('data', function(data) {
+          output += data;
+        });
+        bin.once('close', function() {
+          callback(output);
+        });
+      }
+
+      compile(function(first) {
+        compile(function(second) {
+          assert.strictEqual(second, first);
+          assert.strictEqual(read(calls, 'utf8'), 'theme\n');
+
+          var later = new Date(Date.now() + 10000);
+          fs.writeFileSync(partial, 'a { color: blue; }');
+          fs.utimesSync(partial, later, later);
+
+          compile(function(third) {
+            assert.ok(third.indexOf('color: blue') !== -1);
+            assert.strictEqual(read(calls, 'utf8'), 'theme\ntheme\n');
+            rimraf.sync(dir);
+            done();
+          });
+        });
+      });
+    });
+
+    it('should report errors and exit with an error code', function(done) {
+      var bin = spawn(cli, ['--connect', socket, fixture('invalid/index.scss')]);
+
+      bin.once('close', function(code) {
+        assert.strictEqual(code, 1);
+        done();
+      });
+    });
+
+    it('should answer malformed messages with an error and keep running', function(done) {
+      var client = net.connect(socket);
+      var reply = '';
+
+      client.setEncoding('utf8');
+      client.on('data', function(chunk) {
+        reply += chunk;
+      });
+      client.on('close', function() {
+        assert.strictEqual(JSON.parse(reply).event, 'error');
+
+        var bin = spawn(cli, ['--connect', socket, fixture('simple/index.scss')]);
+        bin.once('close', function(code) {
+          assert.strictEqual(code, 0);
+          done();
+        });
+      });
+      client.write('{not json\n');
+    });
+
+    it('should not take over the socket of a running server', function(done) {
+      if (process.platform === 'win32') {
+        this.skip();
+      }
+
+      var bin = spawn(cli, ['--server', socket]);
+
+      bin.once('close', function(code) {
+        assert.strictEqual(code, 1);
+        done();
+      });
+    });
+  });
+
+  describe('node-sass --server file', function() {
+    it('should not remove a file that is not a socket', function(done) {
+      if (process.platform === 'win32') {
+        this.skip();
+      }
+
+      var file = path.join(os.tmpdir(), 'node-sass-' + process.pid + '.css');
+      fs.writeFileSync(file, 'a {}');
+
+      var bin = spawn(cli, ['--server', file]);
+
+      bin.once('close', function(code) {
+        assert.strictEqual(code, 1);
+        assert.strictEqual(read(file, 'utf8'), 'a {}');
+        fs.unlinkSync(file);
+        done();
+      });
+    });
+  });
 });